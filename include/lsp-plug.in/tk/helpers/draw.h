@@ -43,8 +43,16 @@ namespace lsp
                 const ws::rectangle_t *size, bool flat
         );
 
+        /** Drop glass surface
+         *
+         * @param pool the surface pool to return the surface, can be NULL
+         * @param g pointer to pointer that stores address of the surface object
+         */
+        void drop_glass(SurfacePool *pool, ws::ISurface **g);
+
         /** Create glass
          *
+         * @param pool the surface pool to take and return surfaces, can be NULL
          * @param s the factory surface
          * @param g pointer to pointer that stores address of the surface object
          * @param c color of the glass
@@ -54,13 +62,14 @@ namespace lsp
          * @param mask the radius drawing mask
          * @return pointer to the glass on succes or null on error
          */
-        ws::ISurface *create_glass(ws::ISurface **g, ws::ISurface *s,
+        ws::ISurface *create_glass(SurfacePool *pool, ws::ISurface **g, ws::ISurface *s,
                 const lsp::Color &c,
                 size_t mask, ssize_t radius, size_t width, size_t height
         );
 
         /** Create glass with border
          *
+         * @param pool the surface pool to take and return surfaces, can be NULL
          * @param s the factory surface
          * @param g pointer to pointer that stores address of the surface object
          * @param width the width of the glass
@@ -73,7 +82,7 @@ namespace lsp
          * @return pointer to the glass on succes or null on error
          */
         ws::ISurface * create_border_glass(
-            ws::ISurface **g, ws::ISurface *s,
+            SurfacePool *pool, ws::ISurface **g, ws::ISurface *s,
             const lsp::Color &gc, const lsp::Color &bc,
             size_t mask, ssize_t thick, ssize_t radius,
             size_t width, size_t height, bool flat
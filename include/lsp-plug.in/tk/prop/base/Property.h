@@ -70,6 +70,7 @@ namespace lsp
                 void                sync(bool notify = true);   // Save property to style
                 virtual void        push();                     // Push implementation-specific data to style
                 virtual void        commit(atom_t property);    // Commit changes from style
+                void                discard_updates();          // Discard updates posted to the display queue
 
             protected:
                 explicit Property(prop::Listener *listener = NULL);
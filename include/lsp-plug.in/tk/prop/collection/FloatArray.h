@@ -41,6 +41,10 @@ namespace lsp
 
             protected:
                 lltl::darray<float>     vItems;
+                size_t                  nChanged;       // Index of the first item changed since the last commit
+
+            protected:
+                inline void             mark_changed(size_t index)  { nChanged = lsp_min(nChanged, index); }
 
             protected:
                 explicit FloatArray(prop::Listener *listener = NULL);
@@ -72,6 +76,20 @@ namespace lsp
                  */
                 float               get(size_t index) const;
 
+                /**
+                 * Get index of the first item that has been changed since the last call
+                 * of commit_changes(). All items starting with this index should be considered
+                 * as modified. Allows to update any data derived from the array incrementally.
+                 *
+                 * @return index of the first changed item, equal or greater than size() if there were no changes
+                 */
+                inline size_t       first_changed() const   { return nChanged;              }
+
+                /**
+                 * Mark all items as unchanged
+                 */
+                inline void         commit_changes()        { nChanged = vItems.size();     }
+
             public:
                 /**
                  * Clear the collection, trims the array to 0 elements
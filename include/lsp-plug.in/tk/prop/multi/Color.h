@@ -56,11 +56,17 @@ namespace lsp
             protected:
                 atom_t              vAtoms[P_COUNT];    // Atom bindings
                 lsp::Color          sColor;             // Color holder
+                mutable lsp::Color  sBright;            // Cached color with luminance scaled by brightness
+                mutable float       fBright;            // Brightness of the cached color
+                mutable bool        bBright;            // Cached color is valid
 
             protected:
                 virtual void        push();
                 virtual void        commit(atom_t property);
 
+                // All modifications of the color are followed by sync(), invalidate the cached color there
+                inline void         sync(bool notify = true)    { bBright = false; Property::sync(notify); }
+
             protected:
                 explicit Color(prop::Listener *listener = NULL);
                 virtual ~Color();
@@ -237,6 +243,15 @@ namespace lsp
                 inline const lsp::Color *color() const       { return &sColor; }
                 operator const lsp::Color *() const          { return &sColor; }
 
+                /**
+                 * Get the color with luminance scaled by the brightness factor. The result is cached
+                 * until the color or the brightness factor changes
+                 *
+                 * @param brightness brightness factor
+                 * @return pointer to the color with scaled luminance
+                 */
+                const lsp::Color        *bright_color(float brightness) const;
+
             public:
                 static bool             parse(lsp::Color *c, const char *text, Style *style);
 
@@ -30,6 +30,9 @@ namespace lsp
 {
     namespace tk
     {
+        class Display;
+        class TextCache;
+
         /**
          * Font property that holds font parameters
          */
@@ -85,6 +88,10 @@ namespace lsp
                 virtual void        push();
                 virtual void        commit(atom_t property);
 
+                TextCache          *text_cache(Display *dpy) const;
+                static ws::ISurface *estimation_surface(Display *dpy);
+                bool                calc_multitext_parameters(ws::ISurface *s, const ws::Font *f, ws::text_parameters_t *tp, const LSPString *text, ssize_t first, ssize_t last) const;
+
             protected:
                 explicit Font(prop::Listener *listener = NULL);
                 virtual ~Font();
@@ -85,6 +85,9 @@ namespace lsp
 
                 static bool         overlap(const ws::rectangle_t *a, const ws::rectangle_t *b);
                 static bool         is_empty(const ws::rectangle_t *r);
+                static bool         inside(const ws::rectangle_t *a, const ws::rectangle_t *b);
+                static void         bounds(ws::rectangle_t *dst, const ws::rectangle_t *a, const ws::rectangle_t *b);
+                static inline void  bounds(ws::rectangle_t *dst, const ws::rectangle_t *src) { bounds(dst, dst, src); }
 
                 static void         init(ws::rectangle_t *dst, ssize_t left, ssize_t top, ssize_t width, ssize_t height);
         };
@@ -141,6 +141,7 @@ namespace lsp
 
                 static void add(ws::size_limit_t *dst, ssize_t width, ssize_t height);
                 static void scale(ws::size_limit_t *dst, float scale);
+                static bool equals(const ws::size_limit_t *a, const ws::size_limit_t *b);
         };
 
         namespace prop
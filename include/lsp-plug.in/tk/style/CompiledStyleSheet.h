@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-tk-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-tk-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-tk-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-tk-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LSP_PLUG_IN_TK_STYLE_COMPILEDSTYLESHEET_H_
+#define LSP_PLUG_IN_TK_STYLE_COMPILEDSTYLESHEET_H_
+
+#ifndef LSP_PLUG_IN_TK_IMPL
+    #error "use <lsp-plug.in/tk/tk.h>"
+#endif
+
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/io/Path.h>
+
+namespace lsp
+{
+    namespace tk
+    {
+        /**
+         * Compiled style sheet. Holds the contents of the style sheet in a compact
+         * binary form: all strings are interned, property values are pre-typed, parent
+         * lists are pre-split and styles are stored in the order of inheritance.
+         * The binary image can be saved to file and mapped back into memory, so the
+         * schema can be configured without parsing the XML document.
+         */
+        class CompiledStyleSheet
+        {
+            private:
+                CompiledStyleSheet & operator = (const CompiledStyleSheet &);
+                CompiledStyleSheet(const CompiledStyleSheet &);
+
+                friend class Schema;
+
+            protected:
+                enum format_t
+                {
+                    F_MAGIC         = 0x53534b54,   // 'TKSS'
+                    F_VERSION       = 1,
+                    F_NONE          = 0xffffffff,   // No reference
+                    F_ROOT          = 1 << 0        // The first style is the root style
+                };
+
+                enum prop_flags_t
+                {
+                    P_TEXT_ONLY     = 1 << 0        // Value is malformed and may be applied to string properties only
+                };
+
+                enum storage_t
+                {
+                    M_NONE,                         // No data
+                    M_HEAP,                         // Data is allocated in the heap
+                    M_MMAP                          // Data is mapped from file
+                };
+
+                typedef struct section_t
+                {
+                    uint32_t            offset;     // Offset from the beginning of the image
+                    uint32_t            count;      // Number of items in section
+                } section_t;
+
+                typedef struct header_t
+                {
+                    uint32_t            magic;      // Magic number
+                    uint32_t            version;    // Format version
+                    uint32_t            size;       // Overall size of the image
+                    uint32_t            flags;      // Flags
+                    uint64_t            checksum;   // Checksum of the source document
+                    uint32_t            title;      // Title of the style sheet
+                    uint32_t            reserved;   // Reserved, should be zero
+                    section_t           strings;    // Interned strings
+                    section_t           chars;      // Character data of strings
+                    section_t           colors;     // Colors
+                    section_t           fonts;      // Fonts
+                    section_t           styles;     // Styles in the order of inheritance
+                    section_t           parents;    // Lists of parents
+                    section_t           props;      // Properties
+                } header_t;
+
+                typedef struct string_t
+                {
+                    uint32_t            offset;     // Offset of the NULL-terminated UTF-8 string in chars section
+                    uint32_t            length;     // Length of the string in bytes
+                } string_t;
+
+                typedef struct color_t
+                {
+                    uint32_t            name;       // Name of the color
+                    float               r, g, b, a; // Color components
+                } color_t;
+
+                typedef struct font_t
+                {
+                    uint32_t            name;       // Name of the font
+                    uint32_t            path;       // Path to font or aliased font name
+                    uint32_t            alias;      // Is an alias
+                } font_t;
+
+                typedef struct style_t
+                {
+                    uint32_t            name;       // Name of the style
+                    uint32_t            parent;     // Index of the first parent
+                    uint32_t            parents;    // Number of parents
+                    uint32_t            prop;       // Index of the first property
+                    uint32_t            props;      // Number of properties
+                } style_t;
+
+                typedef struct prop_t
+                {
+                    uint32_t            name;       // Name of the property
+                    uint32_t            type;       // Type of the pre-parsed value
+                    uint32_t            text;       // Original text of the value
+                    uint32_t            flags;      // Property flags
+                    union
+                    {
+                        int64_t         ivalue;
+                        float           fvalue;
+                        uint32_t        bvalue;
+                    };
+                } prop_t;
+
+                struct compiler_t;
+
+            protected:
+                uint8_t                *pData;      // Binary image
+                size_t                  nSize;      // Size of binary image
+                size_t                  nStorage;   // Storage of the image
+                const header_t         *pHeader;    // Image header
+                const string_t         *vStrings;   // Interned strings
+                const char             *vChars;     // Character data
+                const color_t          *vColors;    // Colors
+                const font_t           *vFonts;     // Fonts
+                const style_t          *vStyles;    // Styles
+                const uint32_t         *vParents;   // Parents
+                const prop_t           *vProps;     // Properties
+
+            protected:
+                static status_t         intern(compiler_t *c, const LSPString *s, uint32_t *id);
+                static status_t         emit_style(compiler_t *c, const StyleSheet::style_t *s);
+                static ssize_t          cmp_names(const LSPString *a, const LSPString *b);
+
+                status_t                bind_image(uint8_t *data, size_t size, size_t storage);
+                static status_t         load_file(const LSPString *path, uint8_t **data, size_t *size, size_t *storage);
+                status_t                write_file(const LSPString *path) const;
+                static status_t         validate(const uint8_t *data, size_t size);
+                static void             free_image(uint8_t *data, size_t size, size_t storage);
+
+                inline const char      *string(uint32_t id) const       { return &vChars[vStrings[id].offset];  }
+
+            public:
+                explicit CompiledStyleSheet();
+                ~CompiledStyleSheet();
+
+            public:
+                /**
+                 * Compile the style sheet into binary image
+                 * @param sheet style sheet to compile
+                 * @param checksum checksum of the source document, stored in the image
+                 * @return status of operation
+                 */
+                status_t                compile(const StyleSheet *sheet, uint64_t checksum = 0);
+
+                /**
+                 * Load binary image from file. Where possible, the file is mapped into memory.
+                 * The image is validated before it is accepted.
+                 * @param path path to the file
+                 * @return status of operation
+                 */
+                status_t                load(const char *path);
+                status_t                load(const LSPString *path);
+                status_t                load(const io::Path *path);
+
+                /**
+                 * Save binary image to file
+                 * @param path path to the file
+                 * @return status of operation
+                 */
+                status_t                save(const char *path) const;
+                status_t                save(const LSPString *path) const;
+                status_t                save(const io::Path *path) const;
+
+                /**
+                 * Release the binary image
+                 */
+                void                    close();
+
+                /**
+                 * Compute checksum of the source document to detect stale images
+                 * @param text text of the source document
+                 * @return checksum
+                 */
+                static uint64_t         checksum(const LSPString *text);
+
+            public:
+                inline bool             is_valid() const                { return pHeader != NULL;                           }
+                inline const void      *data() const                    { return pData;                                     }
+                inline size_t           size() const                    { return nSize;                                     }
+                inline uint64_t         source_checksum() const         { return (pHeader != NULL) ? pHeader->checksum : 0; }
+
+                const char             *title() const;
+                size_t                  styles() const;
+                const char             *style_name(size_t index) const;
+                ssize_t                 index_of(const char *style) const;
+        };
+    }
+}
+
+#endif /* LSP_PLUG_IN_TK_STYLE_COMPILEDSTYLESHEET_H_ */
@@ -26,6 +26,7 @@
     #error "use <lsp-plug.in/tk/tk.h>"
 #endif
 
+#include <lsp-plug.in/lltl/darray.h>
 #include <lsp-plug.in/lltl/parray.h>
 #include <lsp-plug.in/lltl/pphash.h>
 #include <lsp-plug.in/runtime/LSPString.h>
@@ -65,6 +66,8 @@ namespace lsp
                 Schema & operator = (const Schema &);
                 Schema(const Schema &);
 
+                friend class CompiledStyleSheet;
+
             protected:
                 enum flags_t
                 {
@@ -84,6 +87,13 @@ namespace lsp
                     LSPString           svalue;
                 } property_value_t;
 
+                typedef struct prop_atoms_t
+                {
+                    const void         *pKey;       // Property descriptor
+                    prop_atoms_t       *pNext;      // Next entry with the same property name
+                    atom_t             *vAtoms;     // Resolved atoms for each descriptor item
+                } prop_atoms_t;
+
             protected:
                 mutable Atoms                      *pAtoms;
                 mutable Display                    *pDisplay;
@@ -92,6 +102,8 @@ namespace lsp
                 lltl::pphash<LSPString, Style>      vBuiltin;
                 lltl::pphash<LSPString, Style>      vStyles;
                 lltl::pphash<LSPString, lsp::Color> vColors;
+                lltl::darray<prop_atoms_t *>        vPropAtoms;     // Cached atoms of multi-properties, indexed by name atom
+                lltl::parray<Style>                 vLocked;        // Styles locked by the schema-wide transaction
 
                 prop::Float                         sScaling;
                 prop::Float                         sFontScaling;
@@ -105,19 +117,34 @@ namespace lsp
                 status_t            unlink_styles();
                 status_t            link_styles(const StyleSheet *sheet);
                 status_t            configure_styles(const StyleSheet *sheet);
-                static bool         check_parents_configured(Style *s);
+                status_t            lock_styles();
+                status_t            lock_style(Style *s);
+                status_t            unlock_styles();
+                status_t            order_locked(lltl::parray<Style> *dst, Style *s);
+
+                status_t            link_styles(const CompiledStyleSheet *sheet, lltl::parray<Style> *styles);
+                status_t            configure_styles(const CompiledStyleSheet *sheet, lltl::parray<Style> *styles);
 
                 status_t            apply_settings(Style *s, StyleSheet::style_t *xs);
+                status_t            apply_settings(Style *s, const CompiledStyleSheet *sheet, size_t index, lltl::darray<atom_t> *atoms);
+                status_t            apply_relations(Style *s, const CompiledStyleSheet *sheet, size_t index);
                 status_t            apply_relations(Style *s, const lltl::parray<LSPString> *parents);
                 status_t            apply_relations(Style *s, const char *parents);
                 void                destroy_colors();
+                void                destroy_prop_atoms();
+                const atom_t       *find_prop_atoms(atom_t id, const void *key);
+                const atom_t       *create_prop_atoms(atom_t id, const void *key, const lltl::parray<char> *postfix);
                 status_t            init_colors_from_sheet(const StyleSheet *sheet);
+                status_t            init_colors_from_sheet(const CompiledStyleSheet *sheet);
                 status_t            load_fonts_from_sheet(const StyleSheet *sheet, resource::ILoader *loader);
+                status_t            load_fonts_from_sheet(const CompiledStyleSheet *sheet, resource::ILoader *loader);
+                status_t            load_font(const char *name, const char *path, bool alias, resource::ILoader *loader);
                 static status_t     parse_property_value(property_value_t *v, const LSPString *text, property_type_t pt);
 
                 void                bind(Style *root);
 
                 status_t            apply_internal(const StyleSheet *sheet, resource::ILoader *loader);
+                status_t            apply_internal(const CompiledStyleSheet *sheet, resource::ILoader *loader);
 
             public:
                 explicit Schema(Atoms *atoms, Display *dpy);
@@ -176,6 +203,16 @@ namespace lsp
                  */
                 status_t            apply(const StyleSheet *sheet, resource::ILoader *loader = NULL);
 
+                /**
+                 * Apply compiled stylesheet settings to the schema. The result is the same
+                 * as of applying the source style sheet but does not require parsing of
+                 * property values
+                 * @param sheet compiled style sheet
+                 * @param loader resource loader
+                 * @return status of operation
+                 */
+                status_t            apply(const CompiledStyleSheet *sheet, resource::ILoader *loader = NULL);
+
             public:
                 LSP_TK_PROPERTY(Float,          scaling,            &sScaling)
                 LSP_TK_PROPERTY(Float,          font_scaling,       &sFontScaling)
@@ -203,6 +240,12 @@ namespace lsp
                  */
                 inline Style       *root() { return pRoot;  }
 
+                /**
+                 * Get display the schema is bound to
+                 * @return display or NULL
+                 */
+                inline Display     *display() const { return pDisplay; }
+
                 /**
                  * Get style by class identifier.
                  * If style does not exists, it will be automatically created and bound to the root style
@@ -238,6 +281,36 @@ namespace lsp
                  */
                 const char         *atom_name(atom_t id) const;
 
+                /**
+                 * Get the list of atoms for all components of the multi-property.
+                 * The list is resolved only once for each pair of property name and
+                 * descriptor, all subsequent calls return the cached list
+                 *
+                 * @param id atom of the property name
+                 * @param desc property descriptor
+                 * @return list of atoms in the order of descriptor items or NULL on error
+                 */
+                const atom_t       *property_atoms(atom_t id, const prop::desc_t *desc);
+
+                /**
+                 * Get the list of atoms for all components of the multi-property.
+                 * @param id property name
+                 * @param desc property descriptor
+                 * @return list of atoms in the order of descriptor items or NULL on error
+                 */
+                const atom_t       *property_atoms(const char *id, const prop::desc_t *desc);
+
+                /**
+                 * Get the list of atoms for all flags of the flag property.
+                 * The list is resolved only once for each pair of property name and
+                 * list of flags, all subsequent calls return the cached list
+                 *
+                 * @param id atom of the property name
+                 * @param flags NULL-terminated list of flag name postfixes
+                 * @return list of atoms in the order of flags or NULL on error
+                 */
+                const atom_t       *property_atoms(atom_t id, const char * const *flags);
+
                 /**
                  * Get currently used language
                  * @param dst pointer to store the result
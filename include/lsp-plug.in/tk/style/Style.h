@@ -63,6 +63,7 @@ namespace lsp
                     S_DELAYED           = 1 << 0,   // Delayed notification
                     S_OVERRIDE          = 1 << 1,   // Force overrides
                     S_CONFIGURED        = 1 << 2,   // The changes to style have been configured
+                    S_LOCKED            = 1 << 3,   // Style is locked by the schema-wide transaction
                 };
 
                 typedef struct property_t
@@ -73,6 +74,8 @@ namespace lsp
                     size_t              changes;    // Number of changes
                     size_t              flags;      // Flags
                     Style              *owner;      // Style that is owning a property
+                    ssize_t             first;      // Index of first listener binding, negative if none
+                    ssize_t             last;       // Index of last listener binding, negative if none
 
                     union
                     {
@@ -96,8 +99,16 @@ namespace lsp
                     atom_t              nId;        // Property identifier
                     bool                bNotify;    // Delayed notify flag
                     IStyleListener     *pListener;  // Listener
+                    ssize_t             nPrev;      // Index of previous binding to the same property
+                    ssize_t             nNext;      // Index of next binding to the same property
                 } listener_t;
 
+                typedef struct slot_t
+                {
+                    atom_t              nId;        // Property identifier, negative if slot is empty
+                    ssize_t             nIndex;     // Index of property in the property list
+                } slot_t;
+
                 typedef struct prop_sync_t
                 {
                     property_t         *pProperty;  // Property of this style
@@ -116,6 +127,8 @@ namespace lsp
                 lltl::darray<property_t>        vProperties;
                 lltl::darray<listener_t>        vListeners;
                 lltl::parray<IStyleListener>    vLocks;
+                slot_t                         *vSlots;     // Open-addressing index: atom -> property
+                size_t                          nSlots;     // Capacity of index, power of 2
                 mutable Schema                 *pSchema;
                 size_t                          nFlags;
                 char                           *sName;
@@ -135,6 +148,14 @@ namespace lsp
                 property_t         *get_property_recursive(atom_t id);
                 property_t         *get_parent_property(atom_t id);
                 property_t         *get_property(atom_t id);
+                static inline size_t atom_hash(atom_t id)   { return size_t(id) * 0x9e3779b1;   }
+                slot_t             *find_slot(atom_t id) const;
+                property_t         *alloc_property(atom_t id);
+                void                free_property(property_t *p);
+                bool                rehash(size_t capacity);
+                ssize_t             find_listener(const property_t *p, IStyleListener *listener) const;
+                listener_t         *alloc_listener(property_t *p, ssize_t *index);
+                void                free_listener(property_t *p, ssize_t index);
                 status_t            set_property(atom_t id, property_t *src);
                 status_t            sync_property(property_t *p);
                 property_t         *create_property(atom_t id, const property_t *src, size_t flags);
@@ -156,9 +177,11 @@ namespace lsp
                 status_t            inheritance_tree(lltl::parray<Style> *dst);
 
                 bool                set_configured(bool set);
+                bool                set_locked(bool set);
                 inline const char  *name() const            { return sName;                 }
                 inline const char  *default_parents() const { return sDflParents;           }
                 inline bool         configured() const      { return nFlags & S_CONFIGURED; }
+                inline bool         locked() const          { return nFlags & S_LOCKED;     }
 
             public:
                 /** Set override mode for the style
@@ -26,6 +26,7 @@
     #error "use <lsp-plug.in/tk/tk.h>"
 #endif
 
+#include <lsp-plug.in/lltl/darray.h>
 #include <lsp-plug.in/lltl/parray.h>
 #include <lsp-plug.in/lltl/pphash.h>
 #include <lsp-plug.in/runtime/LSPString.h>
@@ -50,13 +51,22 @@ namespace lsp
                 StyleSheet(const StyleSheet &);
 
                 friend class Schema;
+                friend class CompiledStyleSheet;
 
             protected:
+                enum state_t
+                {
+                    S_NONE,                                             // Style has not been visited
+                    S_PATH,                                             // Style is in the path of inheritance
+                    S_DONE                                              // Style has been added to the ordered list
+                };
+
                 typedef struct style_t
                 {
                     LSPString                               name;       // Name of style
                     lltl::parray<LSPString>                 parents;    // List of parents
                     lltl::pphash<LSPString, LSPString>      properties; // properties
+                    size_t                                  state;      // Validation state
 
                     style_t();
                     ~style_t();
@@ -71,14 +81,15 @@ namespace lsp
 
                 typedef struct path_t
                 {
-                    lltl::parray<style_t>                   visited;
-                    style_t                                *curr;
+                    style_t                                *curr;       // Current style
+                    size_t                                  index;      // Index of the next parent to visit
                 } path_t;
 
             protected:
                 LSPString                           sTitle;     // Schema title
                 style_t                            *pRoot;      // Root style
                 lltl::pphash<LSPString, style_t>    vStyles;    // Additional named styles
+                lltl::parray<style_t>               vOrder;     // Named styles in the order of inheritance
                 lltl::pphash<LSPString, font_t>     vFonts;     // Additional fonts
                 lltl::pphash<LSPString, lsp::Color> vColors;    // Color map
                 lltl::pphash<LSPString, LSPString>  vConstants; // Global constants
@@ -110,7 +121,7 @@ namespace lsp
 
                 status_t            validate();
                 status_t            validate_style(style_t *s);
-                static void         drop_paths(lltl::parray<path_t> *paths);
+                static ssize_t      cmp_styles(const style_t *a, const style_t *b);
 
             public:
                 status_t            parse_file(const char *path, const char *charset = NULL);
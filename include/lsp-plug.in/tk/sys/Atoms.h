@@ -42,7 +42,24 @@ namespace lsp
                 Atoms(const Atoms &);
 
             protected:
-                lltl::parray<char>      vAtoms;
+                typedef struct bucket_t
+                {
+                    size_t                  nHash;      // Hash of the atom name
+                    atom_t                  nId;        // Atom identifier, negative for empty bucket
+                } bucket_t;
+
+            protected:
+                lltl::parray<char>      vAtoms;         // Atom names, the index is atom identifier
+                lltl::parray<char>      vChunks;        // Memory chunks that store atom names
+                bucket_t               *vBuckets;       // Open-addressing hash index of atoms
+                size_t                  nBuckets;       // Capacity of the hash index, power of 2
+                char                   *pHead;          // Free space in the current chunk
+                size_t                  nLeft;          // Number of free bytes in the current chunk
+
+            protected:
+                static size_t           hash_name(const char *name, size_t *len);
+                char                   *intern(const char *name, size_t len);
+                bool                    rehash(size_t capacity);
 
             public:
                 explicit Atoms();
@@ -39,6 +39,7 @@ namespace lsp
     namespace tk
     {
         class Widget;
+        class Window;
         class SlotSet;
 
         /** Main display
@@ -51,21 +52,39 @@ namespace lsp
                 Display(const Display &);
 
                 friend class Schema;
+                friend class Widget;
 
             protected:
                 typedef struct item_t
                 {
                     Widget         *widget;
                     char           *id;
+                    size_t          nHash;          // Hash of the identifier
+                    size_t          nIndex;         // Index of the item in the list of registered widgets
+                    Widget         *pIndexed;       // Widget the item is indexed by, NULL if not indexed yet
+                    item_t         *pIdNext;        // Next item in the identifier hash bin
+                    item_t         *pWNext;         // Next item in the widget hash bin
                 } item_t;
 
             protected:
                 lltl::parray<item_t>    sWidgets;
+                lltl::parray<item_t>    vUnindexed;         // Items not indexed by the widget pointer yet
+                item_t                **vIdBins;            // Hash index of items by identifier
+                item_t                **vWBins;             // Hash index of items by widget pointer
+                size_t                  nBins;              // Number of bins in each hash index, power of 2
                 lltl::parray<Widget>    vGarbage;
+                lltl::parray<Window>    vRedraw;            // Windows waiting for redraw
+                lltl::parray<Widget>    vBuild;             // Widgets with requests deferred by the build transaction
+                size_t                  nBuildLocks;        // Nesting level of the build transaction
+                ws::taskid_t            nRedrawTask;        // Identifier of the redraw task
+                ws::timestamp_t         nRedrawTime;        // Time the redraw task is scheduled to
                 ipc::Mutex              sLock;
 
                 SlotSet                 sSlots;
                 Schema                  sSchema;
+                SurfacePool             sSurfaces;
+                TextCache               sTextCache;
+                UpdateQueue             sUpdates;
 
                 i18n::IDictionary      *pDictionary;
                 ws::IDisplay           *pDisplay;
@@ -76,10 +95,22 @@ namespace lsp
             protected:
                 void                do_destroy();
                 void                garbage_collect();
+                bool                grow_index();
+                void                index_widgets();
+                item_t             *find_item(const char *id, size_t hash);
+                item_t             *find_item(const Widget *widget);
+                void                unlink_item(item_t *item);
+                static size_t       hash_widget(const Widget *widget);
                 status_t            init_schema();
+                static status_t     read_schema_text(LSPString *dst, io::IInSequence *is);
+                void                schedule_redraw();
+                bool                add_build(Widget *widget);
+                void                cancel_build(Widget *widget);
+                void                render_windows(ws::timestamp_t time);
 
             protected:
                 static status_t     main_task_handler(ws::timestamp_t sched, ws::timestamp_t time, void *arg);
+                static status_t     redraw_task_handler(ws::timestamp_t sched, ws::timestamp_t time, void *arg);
 
             //---------------------------------------------------------------------------------
             // Construction and destruction
@@ -225,6 +256,26 @@ namespace lsp
                  */
                 inline Schema  *schema()                    { return &sSchema; }
 
+                /**
+                 * Get pool of drawing surfaces shared between widgets
+                 * @return pool of drawing surfaces
+                 */
+                inline SurfacePool *surface_pool()          { return &sSurfaces; }
+
+                /**
+                 * Get cache of font and text metrics shared between widgets
+                 * @return cache of font and text metrics
+                 */
+                inline TextCache   *text_cache()            { return &sTextCache; }
+
+                /**
+                 * Get queue of property updates posted by non-UI threads. Updates are
+                 * applied on each iteration of the main loop, the producer thread does
+                 * not need to lock the main event loop.
+                 * @return queue of property updates
+                 */
+                inline UpdateQueue *updates()               { return &sUpdates; }
+
                 /** Get slots
                  *
                  * @return slots
@@ -336,6 +387,55 @@ namespace lsp
                  * @return status of operation
                  */
                 status_t queue_destroy(Widget *widget);
+
+                /**
+                 * Start batched construction of the widget tree. Until the build is finished,
+                 * widgets do not propagate resize and redraw requests to their parents, do not
+                 * emit SLOT_RESIZE and SLOT_REALIZED events, and collect property change
+                 * notifications including those issued by binding properties to the style.
+                 * Calls may be nested.
+                 *
+                 * @return status of operation
+                 */
+                status_t begin_build();
+
+                /**
+                 * Finish batched construction of the widget tree. When the outermost build
+                 * is finished, each affected widget is notified once about each changed
+                 * property, emits pending slot events once and issues its resize and
+                 * redraw requests once.
+                 *
+                 * @return status of operation
+                 */
+                status_t end_build();
+
+                /**
+                 * Check that the batched construction of the widget tree is active
+                 * @return true if batched construction is active
+                 */
+                inline bool building() const                { return nBuildLocks > 0; }
+
+                /**
+                 * Request the window to be rendered. The redraw requests of all windows are
+                 * served by the single scheduler task which is launched only when there are
+                 * pending requests and respects the frame rate of each window.
+                 *
+                 * @param wnd window to render
+                 */
+                void query_redraw(Window *wnd);
+
+                /**
+                 * Cancel the pending redraw request of the window
+                 *
+                 * @param wnd window to remove from redraw queue
+                 */
+                void cancel_redraw(Window *wnd);
+
+                /**
+                 * Get current time in the same time scale used for scheduling display tasks
+                 * @return current time in milliseconds
+                 */
+                static ws::timestamp_t current_time();
         };
     }
 
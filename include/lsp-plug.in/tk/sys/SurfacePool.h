@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-tk-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-tk-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-tk-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-tk-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LSP_PLUG_IN_TK_SYS_SURFACEPOOL_H_
+#define LSP_PLUG_IN_TK_SYS_SURFACEPOOL_H_
+
+#ifndef LSP_PLUG_IN_TK_IMPL
+    #error "use <lsp-plug.in/tk/tk.h>"
+#endif
+
+#include <lsp-plug.in/ws/ISurface.h>
+
+namespace lsp
+{
+    namespace tk
+    {
+        /**
+         * Cache of unused drawing surfaces. Surfaces released by widgets are kept in the
+         * pool grouped by their size and are handed out again when a surface of the same
+         * size is requested. The pool keeps not more than the specified amount of memory,
+         * the least recently released surfaces are destroyed first.
+         */
+        class SurfacePool
+        {
+            private:
+                SurfacePool & operator = (const SurfacePool &);
+                SurfacePool(const SurfacePool &);
+
+            protected:
+                typedef struct item_t
+                {
+                    ws::ISurface   *pSurface;       // The cached surface
+                    size_t          nBytes;         // Estimated amount of memory used by surface
+                    size_t          nBin;           // Hash bin index
+                    item_t         *pPrev;          // Previous (more recently released) item
+                    item_t         *pNext;          // Next (less recently released) item
+                    item_t         *pBinNext;       // Next item in the hash bin
+                } item_t;
+
+            protected:
+                item_t            **vBins;          // Hash bins
+                item_t             *pHead;          // Most recently released item
+                item_t             *pTail;          // Least recently released item
+                size_t              nBudget;        // Maximum amount of memory allowed to keep
+                size_t              nBytes;         // Actual amount of memory held by the pool
+                size_t              nItems;         // Number of surfaces in the pool
+                size_t              nHits;          // Number of successful surface requests
+                size_t              nMisses;        // Number of surface requests that caused allocation
+                bool                bActive;        // The pool accepts surfaces
+
+            protected:
+                static inline size_t    bin_index(size_t width, size_t height);
+                static inline size_t    estimate(size_t width, size_t height);
+                static void             destroy_surface(ws::ISurface *s);
+
+                void                    unlink(item_t *item);
+                void                    shrink(size_t bytes);
+
+            public:
+                explicit SurfacePool();
+                ~SurfacePool();
+
+                /**
+                 * Destroy all cached surfaces, further released surfaces will be destroyed immediately
+                 */
+                void                    destroy();
+
+            public:
+                /**
+                 * Get surface of the specified size. Surfaces taken from the pool are
+                 * cleared to transparent color like the newly created ones.
+                 *
+                 * @param s factory surface used to create new surface if the pool has no appropriate one
+                 * @param width width of the surface
+                 * @param height height of the surface
+                 * @return pointer to surface or NULL on error
+                 */
+                ws::ISurface           *acquire(ws::ISurface *s, size_t width, size_t height);
+
+                /**
+                 * Return the surface to the pool. If the surface does not fit into the memory
+                 * budget, it is destroyed immediately.
+                 *
+                 * @param s surface to release, may be NULL
+                 */
+                void                    release(ws::ISurface *s);
+
+                /**
+                 * Destroy all surfaces cached in the pool
+                 */
+                void                    clear();
+
+                /**
+                 * Set memory budget of the pool, least recently released surfaces
+                 * that do not fit into the new budget are destroyed
+                 *
+                 * @param bytes maximum amount of memory in bytes
+                 */
+                void                    set_budget(size_t bytes);
+
+                inline size_t           budget() const          { return nBudget;       }
+                inline size_t           bytes() const           { return nBytes;        }
+                inline size_t           size() const            { return nItems;        }
+                inline size_t           hits() const            { return nHits;         }
+                inline size_t           misses() const          { return nMisses;       }
+        };
+    }
+}
+
+#endif /* LSP_PLUG_IN_TK_SYS_SURFACEPOOL_H_ */
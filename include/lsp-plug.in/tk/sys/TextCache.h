@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-tk-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-tk-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-tk-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-tk-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LSP_PLUG_IN_TK_SYS_TEXTCACHE_H_
+#define LSP_PLUG_IN_TK_SYS_TEXTCACHE_H_
+
+#ifndef LSP_PLUG_IN_TK_IMPL
+    #error "use <lsp-plug.in/tk/tk.h>"
+#endif
+
+#include <lsp-plug.in/ws/types.h>
+#include <lsp-plug.in/ws/Font.h>
+
+namespace lsp
+{
+    namespace tk
+    {
+        /**
+         * Cache of font and text metrics. The metrics are keyed by the font name,
+         * the effective font size, font flags and the UTF-8 text. The cache holds
+         * not more than the specified number of entries, the least recently used
+         * entries are removed first.
+         */
+        class TextCache
+        {
+            private:
+                TextCache & operator = (const TextCache &);
+                TextCache(const TextCache &);
+
+            protected:
+                enum entry_type_t
+                {
+                    E_FONT,                         // Font parameters
+                    E_TEXT,                         // Single-line text parameters
+                    E_MULTITEXT                     // Multi-line text parameters
+                };
+
+                typedef struct item_t
+                {
+                    size_t                  nHash;      // Hash of the key
+                    size_t                  nType;      // Type of the entry
+                    float                   fSize;      // Font size
+                    size_t                  nFlags;     // Font flags
+                    size_t                  nAntialias; // Font antialiasing
+                    size_t                  nNameLen;   // Length of the font name
+                    size_t                  nTextLen;   // Length of the text
+                    char                   *pKey;       // Font name followed by the text
+                    ws::font_parameters_t   sFP;        // Cached font parameters
+                    ws::text_parameters_t   sTP;        // Cached text parameters
+                    item_t                 *pPrev;      // Previous (more recently used) item
+                    item_t                 *pNext;      // Next (less recently used) item
+                    item_t                 *pBinNext;   // Next item in the hash bin
+                } item_t;
+
+                typedef struct key_t
+                {
+                    size_t                  nHash;
+                    size_t                  nType;
+                    const ws::Font         *pFont;
+                    const char             *pName;
+                    size_t                  nNameLen;
+                    const char             *pText;
+                    size_t                  nTextLen;
+                } key_t;
+
+            protected:
+                item_t            **vBins;          // Hash bins
+                item_t             *pHead;          // Most recently used item
+                item_t             *pTail;          // Least recently used item
+                size_t              nCapacity;      // Maximum number of items
+                size_t              nItems;         // Actual number of items
+                size_t              nHits;          // Number of cache hits
+                size_t              nMisses;        // Number of cache misses
+
+            protected:
+                static void             make_key(key_t *key, size_t type, const ws::Font *f, const char *text);
+                static bool             matches(const item_t *item, const key_t *key);
+
+                void                    unlink(item_t *item);
+                void                    shrink(size_t items);
+                item_t                 *lookup(const key_t *key);
+                item_t                 *insert(const key_t *key);
+
+            public:
+                explicit TextCache();
+                ~TextCache();
+
+            public:
+                bool                    get_font_parameters(const ws::Font *f, ws::font_parameters_t *fp);
+                void                    put_font_parameters(const ws::Font *f, const ws::font_parameters_t *fp);
+
+                bool                    get_text_parameters(const ws::Font *f, const char *text, ws::text_parameters_t *tp);
+                void                    put_text_parameters(const ws::Font *f, const char *text, const ws::text_parameters_t *tp);
+
+                bool                    get_multitext_parameters(const ws::Font *f, const char *text, ws::text_parameters_t *tp);
+                void                    put_multitext_parameters(const ws::Font *f, const char *text, const ws::text_parameters_t *tp);
+
+                /**
+                 * Drop all cached entries, should be called when fonts are reloaded
+                 */
+                void                    clear();
+
+                /**
+                 * Set maximum number of cached entries, least recently used entries
+                 * that do not fit into the new capacity are removed
+                 *
+                 * @param items maximum number of entries
+                 */
+                void                    set_capacity(size_t items);
+
+                inline size_t           capacity() const        { return nCapacity;     }
+                inline size_t           size() const            { return nItems;        }
+                inline size_t           hits() const            { return nHits;         }
+                inline size_t           misses() const          { return nMisses;       }
+        };
+    }
+}
+
+#endif /* LSP_PLUG_IN_TK_SYS_TEXTCACHE_H_ */
@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-tk-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-tk-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-tk-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-tk-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LSP_PLUG_IN_TK_SYS_UPDATEQUEUE_H_
+#define LSP_PLUG_IN_TK_SYS_UPDATEQUEUE_H_
+
+#ifndef LSP_PLUG_IN_TK_IMPL
+    #error "use <lsp-plug.in/tk/tk.h>"
+#endif
+
+#include <lsp-plug.in/lltl/parray.h>
+
+namespace lsp
+{
+    namespace tk
+    {
+        class Float;
+        class RangeFloat;
+        class FloatArray;
+        class GraphMeshData;
+        class GraphFrameData;
+
+        /**
+         * Wait-free single-producer single-consumer queue of property updates. The producer
+         * (for example, the DSP thread) posts updates without taking any locks, the updates
+         * are applied by the UI thread when the queue is drained. If the queue contains
+         * several updates of the same property, only the last one is applied.
+         *
+         * The producer side (post methods) may be used by one thread only, the consumer
+         * side (drain, discard) should be used by the UI thread only.
+         */
+        class UpdateQueue
+        {
+            private:
+                UpdateQueue & operator = (const UpdateQueue &);
+                UpdateQueue(const UpdateQueue &);
+
+            protected:
+                enum update_type_t
+                {
+                    U_SKIP,                             // Unused space at the end of the buffer
+                    U_FLOAT,                            // Value of the float property
+                    U_RANGE_FLOAT,                      // Value of the ranged float property
+                    U_FLOAT_ARRAY,                      // Contents of the float array
+                    U_MESH,                             // Contents of the mesh
+                    U_FRAME_ROW                         // Row of the frame data
+                };
+
+                typedef struct record_t
+                {
+                    uint32_t                nType;      // Type of the update
+                    uint32_t                nUnits;     // Size of the record in units
+                    uint32_t                nParam;     // Type-dependent parameter
+                    uint32_t                nCount;     // Number of floats stored after the record
+                    void                   *pTarget;    // Target property
+                    float                   fValue;     // Float value
+                    uint32_t                nSeq;       // Sequence number, assigned by the consumer
+                } record_t;
+
+            protected:
+                record_t               *vUnits;         // Ring buffer, each record takes one or more units
+                size_t                  nUnits;         // Number of units in the buffer
+                size_t                  nHead;          // First unit to read, modified by the consumer
+                size_t                  nTail;          // First unit to write, modified by the producer
+                lltl::parray<record_t>  vPending;       // Pending records, used by the consumer
+
+            protected:
+                record_t               *begin_record(size_t type, void *target, size_t count);
+                void                    end_record(record_t *rec);
+                void                    apply(record_t *rec);
+                static ssize_t          cmp_records(const record_t *a, const record_t *b);
+
+            public:
+                explicit UpdateQueue();
+                ~UpdateQueue();
+
+                /**
+                 * Initialize the queue
+                 * @param size size of the queue buffer in bytes
+                 * @return status of operation
+                 */
+                status_t                init(size_t size);
+
+                /**
+                 * Destroy the queue, all pending updates are lost
+                 */
+                void                    destroy();
+
+            public:
+                /**
+                 * Post new value of the float property, producer side
+                 * @param prop property to update
+                 * @param value value to set
+                 * @return true if the update has been posted, false if there is not enough space in the queue
+                 */
+                bool                    post(Float *prop, float value);
+
+                /**
+                 * Post new value of the ranged float property, producer side
+                 * @param prop property to update
+                 * @param value value to set
+                 * @return true if the update has been posted, false if there is not enough space in the queue
+                 */
+                bool                    post(RangeFloat *prop, float value);
+
+                /**
+                 * Post new contents of the float array, producer side
+                 * @param prop property to update
+                 * @param v array of values
+                 * @param count number of elements in the array
+                 * @return true if the update has been posted, false if there is not enough space in the queue
+                 */
+                bool                    post(FloatArray *prop, const float *v, size_t count);
+
+                /**
+                 * Post new contents of the mesh data, producer side
+                 * @param prop property to update
+                 * @param x array of x coordinates
+                 * @param y array of y coordinates
+                 * @param size number of elements in each array
+                 * @return true if the update has been posted, false if there is not enough space in the queue
+                 */
+                bool                    post(GraphMeshData *prop, const float *x, const float *y, size_t size);
+
+                /**
+                 * Post the row of the frame data, producer side
+                 * @param prop property to update
+                 * @param id identifier of the row
+                 * @param row row data
+                 * @param columns number of elements in the row
+                 * @return true if the update has been posted, false if there is not enough space in the queue
+                 */
+                bool                    post(GraphFrameData *prop, uint32_t id, const float *row, size_t columns);
+
+            public:
+                /**
+                 * Apply all pending updates, consumer side
+                 * @return number of updates applied
+                 */
+                size_t                  drain();
+
+                /**
+                 * Discard all pending updates of the property, consumer side. Should be
+                 * called before the property is destroyed. Properties bound to the style
+                 * of a widget discard their updates automatically when unbound.
+                 * @param prop property
+                 */
+                void                    discard(const void *prop);
+        };
+    }
+}
+
+#endif /* LSP_PLUG_IN_TK_SYS_UPDATEQUEUE_H_ */
@@ -116,6 +116,7 @@
 
 // Styles and schemas
 #include <lsp-plug.in/tk/style/StyleSheet.h>
+#include <lsp-plug.in/tk/style/CompiledStyleSheet.h>
 #include <lsp-plug.in/tk/style/Style.h>
 #include <lsp-plug.in/tk/style/IStyleFactory.h>
 #include <lsp-plug.in/tk/style/Schema.h>
@@ -126,6 +127,9 @@
 #include <lsp-plug.in/tk/sys/Slot.h>
 #include <lsp-plug.in/tk/sys/SlotSet.h>
 #include <lsp-plug.in/tk/sys/Timer.h>
+#include <lsp-plug.in/tk/sys/SurfacePool.h>
+#include <lsp-plug.in/tk/sys/TextCache.h>
+#include <lsp-plug.in/tk/sys/UpdateQueue.h>
 #include <lsp-plug.in/tk/sys/Display.h>
 
 // Utilitary objects
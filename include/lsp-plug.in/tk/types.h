@@ -31,6 +31,8 @@
 #define LSP_TK_ENV_DICT_PATH_DFL        "i18n"
 // The default dictionary location
 #define LSP_TK_ENV_SCHEMA_PATH          "schema"
+// The location of the compiled schema cache file
+#define LSP_TK_ENV_SCHEMA_CACHE         "schema.cache"
 // The default language selected at startup
 #define LSP_TK_ENV_LANG                 "language"
 #define LSP_TK_ENV_LANG_DFL             "en"
@@ -154,6 +156,18 @@ namespace lsp
             GFF_DEFAULT = GFF_RAINBOW   //!< GFF_DEFAULT default function
         };
 
+        /**
+         * Layer of the graph the graph item is rendered to
+         */
+        enum graph_layer_t
+        {
+            GLR_STATIC,                 //!< GLR_STATIC rarely changing items: axes, origins, text
+            GLR_DATA,                   //!< GLR_DATA frequently updated data: meshes, frame buffers
+            GLR_MARKERS,                //!< GLR_MARKERS interactive items: markers, dots
+
+            GLR_TOTAL                   //!< GLR_TOTAL overall number of layers
+        };
+
         enum text_adjust_t
         {
             TA_NONE,                    //!< No text adjust
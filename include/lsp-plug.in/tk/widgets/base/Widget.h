@@ -60,6 +60,8 @@ namespace lsp
                 Widget & operator = (const Widget &);
                 Widget(const Widget &);
 
+                friend class Display;
+
             public:
                 static const w_class_t    metadata;
 
@@ -72,7 +74,20 @@ namespace lsp
                     REDRAW_CHILD    = 1 << 3,       // Need to redraw child only
                     SIZE_INVALID    = 1 << 4,       // Size limit structure is valid
                     RESIZE_PENDING  = 1 << 5,       // The resize request is pending
-                    REALIZE_ACTIVE  = 1 << 6        // Realize is active, no need to trigger for realize
+                    REALIZE_ACTIVE  = 1 << 6,       // Realize is active, no need to trigger for realize
+                    SURFACE_INVALID = 1 << 7,       // Contents of the cached surface are out of date
+                    MOTION_EXACT    = 1 << 8,       // Widget requires every mouse motion event to be delivered
+                    BUILD_PENDING   = 1 << 9,       // Widget is in the list of deferred build requests of the display
+                    BUILD_STYLE     = 1 << 10,      // Style notifications are deferred until the build is finished
+                    BUILD_RESIZE    = 1 << 11,      // Resize has been requested during the build
+                    BUILD_DRAW      = 1 << 12,      // Redraw of the child has been requested during the build
+                    BUILD_DRAW_SURF = 1 << 13,      // Redraw of the surface has been requested during the build
+                    BUILD_RESIZED   = 1 << 14,      // SLOT_RESIZE event is pending
+                    BUILD_REALIZED  = 1 << 15,      // SLOT_REALIZED event is pending
+                    BUILD_PROPS     = 1 << 16,      // Property change notifications are pending
+
+                    BUILD_MASK      = BUILD_PENDING | BUILD_STYLE | BUILD_RESIZE | BUILD_DRAW | BUILD_DRAW_SURF |
+                                      BUILD_RESIZED | BUILD_REALIZED | BUILD_PROPS
                 };
 
             protected:
@@ -99,6 +114,9 @@ namespace lsp
                 SlotSet             sSlots;             // Slots
                 Style               sStyle;             // Style
                 PropListener        sProperties;        // Properties listener
+                lltl::parray<Property>  vBuildProps;    // Properties changed during the build
+                lltl::parray<Widget>   *pBuildList;     // List of deferred build requests the widget is stored in
+                size_t              nBuildIndex;        // Index of the widget in the list of deferred build requests
 
                 prop::Allocation    sAllocation;        // Widget allocation
                 prop::Float         sScaling;           // UI scaling factor
@@ -145,6 +163,12 @@ namespace lsp
 
                 void                    unlink_widget(Widget *widget);
 
+                /**
+                 * Return the surface to the surface pool of the display and reset the pointer
+                 * @param s pointer to the variable that holds the surface
+                 */
+                void                    drop_surface(ws::ISurface **s);
+
                 /**
                  * Callback on call when property has been change
                  * @param prop property that has been changed
@@ -176,6 +200,38 @@ namespace lsp
                  */
                 virtual void            show_widget();
 
+                /** Query resize of the widget and it's parent even if the size limits
+                 * of the widget did not change
+                 */
+                void                    query_parent_resize();
+
+                /**
+                 * Defer requests while the display is building the widget tree
+                 * @param flags build flags of deferred requests
+                 * @return true if requests have been deferred, false if there is no active build
+                 *   or the request could not be registered
+                 */
+                bool                    defer_build(size_t flags);
+
+                /**
+                 * Defer notification about the property change while the display is building
+                 * the widget tree
+                 * @param prop changed property
+                 * @return true if notification has been deferred
+                 */
+                bool                    defer_property(Property *prop);
+
+                /**
+                 * Deliver style and property notifications deferred by the build, each changed
+                 * property is reported once
+                 */
+                void                    commit_build_style();
+
+                /**
+                 * Replay requests and slot events deferred by the build
+                 */
+                void                    commit_build();
+
             //---------------------------------------------------------------------------------
             // Construction and destruction
             public:
@@ -339,6 +395,20 @@ namespace lsp
                  */
                 inline bool             resize_pending() const              { return nFlags & (SIZE_INVALID | RESIZE_PENDING); }
 
+                /** Check if window is allowed to merge consecutive mouse motion events
+                 * addressed to the widget while mouse buttons are pressed
+                 *
+                 * @return true if motion coalescing is allowed
+                 */
+                inline bool             motion_coalescing() const           { return !(nFlags & MOTION_EXACT); }
+
+                /** Allow or deny merging of consecutive mouse motion events addressed to the widget,
+                 * should be denied by widgets which need every motion sample (for example, freehand drawing)
+                 *
+                 * @param enable enable motion coalescing
+                 */
+                inline void             set_motion_coalescing(bool enable)  { nFlags = (enable) ? (nFlags & ~MOTION_EXACT) : (nFlags | MOTION_EXACT); }
+
                 /** Check that specified window coordinate lies within widget's bounds
                  * Always returns false for invisible widgets
                  *
@@ -54,6 +54,50 @@ namespace lsp
             LSP_TK_STYLE_DEF_END
         }
 
+        /**
+         * Data model of the list box. When the model is set, the list box does not
+         * use the list of items and requests only the rows that are displayed
+         */
+        class IListBoxModel
+        {
+            public:
+                virtual ~IListBoxModel();
+
+            public:
+                /**
+                 * Get number of rows
+                 * @return number of rows
+                 */
+                virtual size_t          rows();
+
+                /**
+                 * Get the text of the row
+                 * @param dst destination string to store the text
+                 * @param row index of the row
+                 * @return status of operation
+                 */
+                virtual status_t        format(LSPString *dst, size_t row);
+
+                /**
+                 * Check that the row is selected
+                 * @param row index of the row
+                 * @return true if the row is selected
+                 */
+                virtual bool            selected(size_t row);
+
+                /**
+                 * Change the selection state of the row
+                 * @param row index of the row
+                 * @param selected selection state
+                 */
+                virtual void            select(size_t row, bool selected);
+
+                /**
+                 * Deselect all rows
+                 */
+                virtual void            unselect_all();
+        };
+
         class ListBox: public WidgetContainer
         {
             private:
@@ -132,6 +176,12 @@ namespace lsp
                 ws::rectangle_t                 sList;
                 lltl::darray<item_t>            vVisible;
 
+                IListBoxModel                  *pModel;         // Data model, replaces the list of items when set
+                ListBoxItem                     sModelItem;     // Item that provides the style for rows of the model
+                ssize_t                         nRowHeight;     // Height of the model row
+                ssize_t                         nRowStep;       // Distance between tops of adjacent model rows
+                ssize_t                         nModelWidth;    // Maximum width of model rows measured by now
+
                 prop::WidgetList<ListBoxItem>   vItems;
                 prop::WidgetSet<ListBoxItem>    vSelected;
                 prop::CollectionListener        sIListener;
@@ -156,6 +206,7 @@ namespace lsp
             protected:
                 void                    do_destroy();
                 void                    allocate_items(alloc_t *alloc);
+                void                    allocate_model(alloc_t *alloc);
                 void                    estimate_size(alloc_t *a, const ws::rectangle_t *xr);
                 void                    realize_children();
                 void                    keep_single_selection();
@@ -165,6 +216,11 @@ namespace lsp
                 void                    select_single(ssize_t index, bool add);
                 status_t                on_key_scroll();
                 bool                    scroll_to_item(ssize_t vindex);
+                void                    get_row_rect(ws::rectangle_t *r, ssize_t row);
+                ssize_t                 find_row(ssize_t x, ssize_t y);
+                bool                    scroll_to_row(ssize_t row);
+                void                    scroll_model(size_t mask);
+                void                    render_model(ws::ISurface *s, const ws::rectangle_t *area);
 
             protected:
                 static status_t         slot_on_scroll_change(Widget *sender, void *ptr, void *data);
@@ -216,7 +272,34 @@ namespace lsp
                 LSP_TK_PROPERTY(Integer,            hscroll_spacing,            &sHScrollSpacing)
                 LSP_TK_PROPERTY(Integer,            vscroll_spacing,            &sVScrollSpacing)
 
+                /**
+                 * Get the item which provides style (padding, colors and text adjustment)
+                 * for all rows of the data model
+                 * @return item
+                 */
+                inline ListBoxItem         *model_item()        { return &sModelItem;   }
+
+                /**
+                 * Get the data model
+                 * @return data model or NULL if the list of items is used
+                 */
+                inline IListBoxModel       *model()             { return pModel;        }
+
             public:
+                /**
+                 * Set the data model. When the model is set, the list of items is ignored
+                 * and only rows visible on the screen are requested from the model
+                 * @param model data model or NULL to use the list of items
+                 */
+                void                        set_model(IListBoxModel *model);
+
+                /**
+                 * Notify the list box that the rows of the data model have been changed.
+                 * The width of rows is reset only when the model becomes empty
+                 */
+                void                        update_model();
+
+
                 virtual Widget             *find_widget(ssize_t x, ssize_t y);
 
                 virtual status_t            add(Widget *child);
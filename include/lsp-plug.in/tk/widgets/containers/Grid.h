@@ -60,6 +60,12 @@ namespace lsp
                 {
                     F_EXPAND        = 1 << 0,       // Widget in the cell has 'expand' flag
                     F_REDUCE        = 1 << 1,       // Widget in the cell has 'reduce' flag
+                    F_PREV_EXPAND   = 1 << 2,       // Value of 'expand' flag at the previous layout pass
+                    F_PREV_REDUCE   = 1 << 3,       // Value of 'reduce' flag at the previous layout pass
+                    F_DIRTY         = 1 << 4,       // Size estimate of the header needs to be recomputed
+
+                    F_ALLOC_MASK    = F_EXPAND | F_REDUCE,
+                    F_PREV_SHIFT    = 2
                 };
 
                 typedef struct cell_t
@@ -72,11 +78,16 @@ namespace lsp
                     size_t              nRows;      // Number of rows taken by cell
                     size_t              nCols;      // Number of columns taken by cell
                     size_t              nTag;       // Tag
+                    ssize_t             nMinWidth;  // Cached minimum width of the widget, negative if not estimated
+                    ssize_t             nMinHeight; // Cached minimum height of the widget, negative if not estimated
                 } cell_t;
 
                 typedef struct header_t
                 {
+                    ssize_t             nMin;       // Minimum size required by the single-span cells
+                    ssize_t             nEstimate;  // Minimum size including the multi-span cells
                     ssize_t             nSize;      // Size of the header
+                    ssize_t             nPos;       // Position of the header, valid after realize
                     size_t              nWeight;    // Weight of the header
                     size_t              nSpacing;   // Additional spacing
                     size_t              nFlags;     // Additional flags
@@ -89,6 +100,7 @@ namespace lsp
                     ssize_t             nTop;       // Attached top position, negative for add()
                     size_t              nRows;      // Number of rows taken by widget, should be positive
                     size_t              nCols;      // Number of columns taken by widget, should be positive
+                    bool                bVisible;   // Visibility of the widget at the moment of topology build
                 } widget_t;
 
                 typedef struct alloc_t
@@ -100,11 +112,15 @@ namespace lsp
                     size_t                  nRows;
                     size_t                  nCols;
                     size_t                  nTag;
+                    size_t                  nHSpacing;  // Horizontal spacing used for size estimation
+                    size_t                  nVSpacing;  // Vertical spacing used for size estimation
+                    bool                    bTopology;  // Topology of cells needs to be rebuilt
+                    bool                    bEstimate;  // Size estimation of all rows and columns needs to be recomputed
                 } alloc_t;
 
             protected:
                 lltl::darray<widget_t>      vItems;     // All list of items
-                alloc_t                     sAlloc;     // Allocation
+                alloc_t                     sAlloc;     // Persistent allocation of cells
 
                 prop::Integer               sRows;
                 prop::Integer               sColumns;
@@ -116,7 +132,9 @@ namespace lsp
             protected:
                 void                        do_destroy();
                 static inline bool          hidden_widget(const widget_t *w);
-                status_t                    allocate_cells(alloc_t *a);
+                status_t                    allocate_cells();
+                bool                        check_topology();
+                status_t                    build_topology(alloc_t *a);
                 status_t                    attach_cells(alloc_t *a);
                 static bool                 attach_cell(alloc_t *a, widget_t *w, size_t left, size_t top);
                 static bool                 is_invisible_row(alloc_t *a, size_t row);
@@ -127,9 +145,15 @@ namespace lsp
                 static void                 remove_col(alloc_t *a, size_t id);
                 static size_t               estimate_size(lltl::darray<header_t> *hdr, size_t first, size_t count);
                 static void                 distribute_size(lltl::darray<header_t> *vh, size_t first, size_t count, size_t size);
+                static void                 mark_dirty(lltl::darray<header_t> *hdr, size_t first, size_t count);
+                void                        update_headers(alloc_t *a);
+                static bool                 flags_changed(lltl::darray<header_t> *hdr);
+                static bool                 estimate_row(alloc_t *a, size_t row);
+                static bool                 estimate_col(alloc_t *a, size_t col);
                 status_t                    estimate_sizes(alloc_t *a);
                 status_t                    create_row_col_descriptors(alloc_t *a);
                 static void                 assign_coords(alloc_t *a, const ws::rectangle_t *r);
+                static ssize_t              find_header(lltl::darray<header_t> *hdr, ssize_t pos);
                 static void                 realize_children(alloc_t *a);
                 status_t                    attach_internal(ssize_t left, ssize_t top, Widget *widget, size_t rows, size_t cols);
                 static cell_t              *alloc_cell(lltl::parray<cell_t> *list);
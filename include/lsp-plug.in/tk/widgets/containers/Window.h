@@ -48,6 +48,7 @@ namespace lsp
                 prop::SizeConstraints   sConstraints;
                 prop::Layout            sLayout;
                 prop::WindowPolicy      sPolicy;
+                prop::Float             sFrameRate;
             LSP_TK_STYLE_DEF_END
         }
 
@@ -91,7 +92,13 @@ namespace lsp
                 key_handler_t           hKeys;              // Key handler
 
                 Window                 *pActor;
-                Timer                   sRedraw;
+                ws::timestamp_t         nNextFrame;         // Earliest time to render the next frame
+                lltl::darray<ws::rectangle_t> vDamage;      // List of damaged regions
+                bool                    bFullDamage;        // The whole window is damaged
+                lltl::parray<Widget>    vRelayout;          // Relayout boundaries that need to be realized again
+                ws::event_t             sMotion;            // Deferred mouse motion event
+                bool                    bMotion;            // Deferred mouse motion event is pending
+                ws::taskid_t            nMotionTask;        // Task that delivers deferred mouse motion event
 
                 prop::String            sTitle;
                 prop::String            sRole;
@@ -105,14 +112,17 @@ namespace lsp
                 prop::SizeConstraints   sSizeConstraints;
                 prop::Layout            sLayout;
                 prop::WindowPolicy      sPolicy;
+                prop::Float             sFrameRate;
 
             //---------------------------------------------------------------------------------
             // Slot handlers
             protected:
-                static status_t     tmr_redraw_request(ws::timestamp_t sched, ws::timestamp_t ts, void *args);
                 static status_t     slot_window_close(Widget *sender, void *ptr, void *data);
+                static status_t     motion_task_handler(ws::timestamp_t sched, ws::timestamp_t time, void *arg);
 
                 status_t            do_render();
+                void                render_frame(ws::timestamp_t time);
+                void                relayout_widgets();
                 void                do_destroy();
                 virtual status_t    sync_size();
                 status_t            update_pointer();
@@ -121,6 +131,10 @@ namespace lsp
                 virtual Widget     *sync_mouse_handler(const ws::event_t *e, bool lookup);
                 virtual Widget     *acquire_mouse_handler(const ws::event_t *e);
                 virtual Widget     *release_mouse_handler(const ws::event_t *e, bool lookup);
+                status_t            handle_motion(const ws::event_t *e);
+                bool                defer_motion(const ws::event_t *e);
+                status_t            flush_motion();
+                void                drop_motion();
 
                 // Focus operations
                 inline bool         check_focus(Widget *w) const    { return pFocused == w; }
@@ -143,6 +157,26 @@ namespace lsp
                  */
                 void                discard_widget(Widget *w);
 
+                /**
+                 * Add the damaged region to the window, the region will be repainted on the next render cycle
+                 * @param r damaged region relative to the window, NULL means the whole window
+                 */
+                void                query_damage(const ws::rectangle_t *r);
+
+                /**
+                 * Request the widget to be realized again within it's current allocation on the
+                 * next render cycle. Used by widgets which changed their contents but kept their size limits
+                 * @param w widget to relayout
+                 */
+                void                query_relayout(Widget *w);
+
+                /**
+                 * Check that the widget is queued for relayout within it's current allocation
+                 * @param w widget to check
+                 * @return true if the widget is queued for relayout
+                 */
+                inline bool         relayout_pending(Widget *w)         { return vRelayout.index_of(w) >= 0; }
+
             //---------------------------------------------------------------------------------
             // Construction and destruction
             public:
@@ -200,6 +234,7 @@ namespace lsp
                 LSP_TK_PROPERTY(SizeConstraints,    constraints,        &sSizeConstraints)
                 LSP_TK_PROPERTY(Layout,             layout,             &sLayout)
                 LSP_TK_PROPERTY(WindowPolicy,       policy,             &sPolicy)
+                LSP_TK_PROPERTY(Float,              frame_rate,         &sFrameRate)
                 LSP_TK_PROPERTY(Widget,             child,              pChild)
                 LSP_TK_PROPERTY(Position,           position,           &sPosition)
 
@@ -208,6 +243,10 @@ namespace lsp
             public:
                 virtual void            render(ws::ISurface *s, const ws::rectangle_t *area, bool force);
 
+                virtual void            query_draw(size_t flags = REDRAW_SURFACE);
+
+                virtual void            query_resize();
+
                 virtual status_t        override_pointer(bool override = true);
 
                 /** Show window
@@ -28,6 +28,8 @@
 
 #include <lsp-plug.in/fmt/bookmarks.h>
 #include <lsp-plug.in/lltl/parray.h>
+#include <lsp-plug.in/ipc/Mutex.h>
+#include <lsp-plug.in/ipc/Thread.h>
 
 namespace lsp
 {
@@ -69,7 +71,14 @@ namespace lsp
                     F_ISOTHER   = 1 << 3,
                     F_ISINVALID = 1 << 4,
                     F_DOTDOT    = 1 << 5,
-                    F_ISHIDDEN  = 1 << 6
+                    F_ISHIDDEN  = 1 << 6,
+                    F_SELECTED  = 1 << 7
+                };
+
+                enum scan_const_t
+                {
+                    SCAN_BATCH_SIZE     = 256,      // Number of entries collected by the worker before passing them to the UI
+                    SCAN_POLL_PERIOD    = 100       // Period of fetching scanned entries by the UI, milliseconds
                 };
 
                 typedef struct f_entry_t
@@ -78,6 +87,26 @@ namespace lsp
                     size_t                  nFlags;
                 } f_entry_t;
 
+                class FileListModel: public IListBoxModel
+                {
+                    public:
+                        lltl::parray<f_entry_t>     vRows;          // Entries shown in the list
+                        lltl::parray<f_entry_t>     vSelected;      // Selected entries
+
+                    public:
+                        virtual ~FileListModel();
+
+                    public:
+                        virtual size_t              rows();
+                        virtual status_t            format(LSPString *dst, size_t row);
+                        virtual bool                selected(size_t row);
+                        virtual void                select(size_t row, bool selected);
+                        virtual void                unselect_all();
+
+                    public:
+                        void                        clear();
+                };
+
                 typedef struct bm_entry_t
                 {
                     Hyperlink               sHlink;
@@ -87,6 +116,17 @@ namespace lsp
                     inline bm_entry_t(Display *dpy): sHlink(dpy) {}
                 } bm_entry_t;
 
+                typedef struct scan_t
+                {
+                    ipc::Thread                *pThread;        // Worker thread that reads the directory
+                    ipc::Mutex                  sLock;          // Lock for the fields below
+                    io::Path                    sPath;          // Path to the directory
+                    lltl::parray<f_entry_t>     vBatch;         // Entries not yet fetched by the UI
+                    status_t                    nResult;        // Result of the scan
+                    bool                        bDone;          // Scan has been completed
+                    volatile bool               bCancel;        // Scan has been cancelled
+                } scan_t;
+
             protected:
                 Edit                        sWPath;         // Current path
                 Edit                        sWSearch;       // File pattern search input
@@ -117,6 +157,11 @@ namespace lsp
                 lltl::parray<Widget>        vWidgets;
                 lltl::parray<bm_entry_t>    vBookmarks;
                 lltl::parray<f_entry_t>     vFiles;
+                FileListModel               sFileModel;     // Data model of the file list
+                lltl::parray<scan_t>        vScans;         // Cancelled scans waiting for the worker to terminate
+
+                scan_t                     *pScan;          // Active directory scan
+                Timer                       sScanTimer;     // Timer for fetching scan results
 
                 bm_entry_t                 *pSelBookmark;
                 bm_entry_t                 *pPopupBookmark;
@@ -219,13 +264,25 @@ namespace lsp
                 status_t                init_bookmark_entry(bm_entry_t *ent, const io::Path *path);
                 status_t                inject_style(tk::Widget *w, const char *name);
 
-                void                    destroy_file_entries(lltl::parray<f_entry_t> *list);
+                static void             destroy_file_entries(lltl::parray<f_entry_t> *list);
+                void                    drop_file_entries();
                 status_t                refresh_current_path();
-                status_t                add_file_entry(lltl::parray<f_entry_t> *dst, const char *name, size_t flags);
-                status_t                add_file_entry(lltl::parray<f_entry_t> *dst, const LSPString *name, size_t flags);
+                static status_t         add_file_entry(lltl::parray<f_entry_t> *dst, const char *name, size_t flags);
+                static status_t         add_file_entry(lltl::parray<f_entry_t> *dst, const LSPString *name, size_t flags);
                 static ssize_t          cmp_file_entry(const f_entry_t *a, const f_entry_t *b);
+                status_t                merge_file_entries(lltl::parray<f_entry_t> *list);
                 f_entry_t              *selected_entry();
 
+                static status_t         scan_directory(void *arg);
+                static status_t         pass_scanned_entries(scan_t *scan, lltl::parray<f_entry_t> *list, bool done, status_t result);
+                static status_t         scan_timer_handler(ws::timestamp_t sched, ws::timestamp_t time, void *arg);
+                static void             destroy_scan(scan_t *scan);
+                status_t                start_scan(const io::Path *path);
+                void                    cancel_scan();
+                void                    reap_scans(bool wait);
+                status_t                fetch_scanned_entries();
+                void                    show_scan_error(status_t code);
+
                 status_t                sync_filters();
                 status_t                apply_filters();
 
@@ -62,6 +62,21 @@ namespace lsp
                 Graph & operator    = (const Graph &);
                 Graph(const Graph &);
 
+            protected:
+                enum hit_index_t
+                {
+                    HIT_BIN_SIZE        = 32                    // Size of the hit-test index bin in pixels
+                };
+
+                typedef struct hit_range_t
+                {
+                    size_t                          nIndex;         // Index of the item
+                    size_t                          nFirstCol;      // First column of bins
+                    size_t                          nLastCol;       // Last column of bins
+                    size_t                          nFirstRow;      // First row of bins
+                    size_t                          nLastRow;       // Last row of bins
+                } hit_range_t;
+
             protected:
                 prop::WidgetList<GraphItem>     vItems;         // Overall list of graph items
                 lltl::parray<GraphAxis>         vAxis;          // List of all axes
@@ -80,9 +95,18 @@ namespace lsp
                 prop::Padding                   sIPadding;      // Internal padding
 
                 ws::ISurface                   *pGlass;         // Cached glass gradient
+                ws::ISurface                   *vLayers[GLR_TOTAL]; // Cached layers of graph items
+                size_t                          nLayers;        // Mask of layers that need to be redrawn
                 ws::rectangle_t                 sCanvas;        // Actual dimensions of the drawing area (with padding)
                 ws::rectangle_t                 sICanvas;       // Actual dimensions of the drawing area (without padding)
 
+                lltl::darray<size_t>            vHitBins;       // Hit-test index: offsets of bins in the list of items
+                lltl::darray<size_t>            vHitItems;      // Hit-test index: indices of items stored in bins
+                lltl::darray<size_t>            vHitAny;        // Hit-test index: indices of items tested at any position
+                size_t                          nHitCols;       // Number of columns of bins
+                size_t                          nHitRows;       // Number of rows of bins
+                bool                            bHitIndex;      // Hit-test index is valid
+
             protected:
                 void                        do_destroy();
 
@@ -98,6 +122,10 @@ namespace lsp
 
                 void                        sync_lists();
                 void                        drop_glass();
+                void                        drop_layers();
+                void                        drop_hit_index();
+                bool                        build_hit_index();
+                ws::ISurface               *render_layer(ws::ISurface *s, size_t layer);
 
             public:
                 explicit Graph(Display *dpy);
@@ -167,6 +195,26 @@ namespace lsp
 
                 virtual status_t            remove_all();
 
+                virtual void                query_draw(size_t flags = REDRAW_SURFACE);
+
+                /**
+                 * Request redraw of the specific layer of the graph only
+                 * @param layer layer to redraw
+                 */
+                void                        query_draw_layer(size_t layer);
+
+                /**
+                 * Request redraw of the specific layers of the graph only
+                 * @param mask mask of layers to redraw
+                 */
+                void                        query_draw_layers(size_t mask);
+
+                /**
+                 * Request rebuild of the hit-test index, should be called when the geometry
+                 * or the visibility of items that can be hit by the mouse pointer changes
+                 */
+                inline void                 query_hit_index()       { bHitIndex = false;    }
+
                 virtual void                render(ws::ISurface *s, const ws::rectangle_t *area, bool force);
 
                 virtual void                draw(ws::ISurface *s);
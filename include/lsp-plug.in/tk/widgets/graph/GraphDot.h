@@ -117,6 +117,7 @@ namespace lsp
 
             protected:
                 void                        apply_motion(ssize_t x, ssize_t y, size_t flags);
+                bool                        get_hit_circle(float *x, float *y, float *r);
 
                 static status_t             slot_on_change(Widget *sender, void *ptr, void *data);
 
@@ -160,8 +161,12 @@ namespace lsp
             public:
                 virtual void                render(ws::ISurface *s, const ws::rectangle_t *area, bool force);
 
+                virtual graph_layer_t       layer() const;
+
                 virtual bool                inside(ssize_t x, ssize_t y);
 
+                virtual bool                hit_area(ws::rectangle_t *r);
+
                 virtual status_t            on_mouse_in(const ws::event_t *e);
 
                 virtual status_t            on_mouse_out(const ws::event_t *e);
@@ -58,6 +58,12 @@ namespace lsp
             protected:
                 typedef void (GraphFrameBuffer::*calc_color_t)(float *rgba, const float *value, size_t n);
 
+                enum lut_const_t
+                {
+                    LUT_SIZE            = 4096,         // Number of entries in the color lookup table
+                    LUT_CHUNK           = 256           // Number of entries computed at once
+                };
+
             protected:
                 prop::GraphFrameData        sData;              // Framebuffer data
                 prop::Float                 sTransparency;      // Framebuffer transparency
@@ -72,11 +78,14 @@ namespace lsp
                 bool                        bClear;             // Perform full cleanup of image
                 size_t                      nRows;              // Cached number of rows
                 size_t                      nCols;              // Cached number of columns
+                size_t                      nHead;              // Surface row holding the most recent data row
                 calc_color_t                pCalcColor;         // Function to compute
 
-                float                      *fRGBA;              // RGBA buffer
-                uint8_t                    *pfRGBA;             // Unaligned RGBA buffer
-                size_t                      nCapacity;          // RGBA buffer capacity
+                bool                        bSyncLUT;           // Need to rebuild the color lookup table
+                float                       fLutMin;            // Minimum value covered by the lookup table
+                float                       fLutMax;            // Maximum value covered by the lookup table
+                uint32_t                   *vLUT;               // Color lookup table, BGRA32 pixels
+                uint8_t                    *pLUT;               // Unaligned lookup table data
 
             protected:
                 void                        calc_rainbow_color(float *rgba, const float *value, size_t n);
@@ -86,6 +95,8 @@ namespace lsp
                 void                        calc_lightness2(float *rgba, const float *value, size_t n);
 
                 void                        destroy_data();
+                bool                        sync_lut();
+                void                        lut_to_bgra32(void *dst, const float *v, size_t n);
 
                 virtual void                property_changed(Property *prop);
 
@@ -110,6 +121,8 @@ namespace lsp
             public:
                 virtual void                render(ws::ISurface *s, const ws::rectangle_t *area, bool force);
 
+                virtual graph_layer_t       layer() const;
+
                 virtual void                draw(ws::ISurface *s);
         };
     }
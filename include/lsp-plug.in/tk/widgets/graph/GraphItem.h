@@ -54,6 +54,8 @@ namespace lsp
 
             protected:
                 virtual void            property_changed(Property *prop);
+                virtual void            hide_widget();
+                virtual void            show_widget();
 
             public:
                 explicit GraphItem(Display *dpy);
@@ -75,6 +77,19 @@ namespace lsp
 
                 virtual void        query_draw(size_t flags = REDRAW_SURFACE);
 
+                /**
+                 * Get the layer of the graph the item is rendered to
+                 * @return layer of the graph
+                 */
+                virtual graph_layer_t   layer() const;
+
+                /**
+                 * Get the mask of graph layers that should be redrawn when the item changes,
+                 * the item may affect the positions of items rendered to other layers
+                 * @return mask of graph layers
+                 */
+                virtual size_t          affected_layers() const;
+
                 /**
                  * Check whether mouse pointer is inside of the graph item
                  * @param x horizontal position of mouse pointer
@@ -82,6 +97,16 @@ namespace lsp
                  * @return true if item is inside of the graph
                  */
                 virtual bool        inside(ssize_t x, ssize_t y);
+
+                /**
+                 * Get the area of the graph where the item can be hit by the mouse pointer,
+                 * used by the graph to build the hit-test index. Items that override inside()
+                 * should override this method too.
+                 * @param r pointer to store the area in window coordinates, empty area if the
+                 *   item can not be hit at all
+                 * @return false if the item can be hit at any point of the graph and should always be tested
+                 */
+                virtual bool        hit_area(ws::rectangle_t *r);
         };
 
     }
@@ -97,6 +97,8 @@ namespace lsp
 
             public:
                 virtual void                render(ws::ISurface *s, const ws::rectangle_t *area, bool force);
+
+                virtual graph_layer_t       layer() const;
         };
     }
 }
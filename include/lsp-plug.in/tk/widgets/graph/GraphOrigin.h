@@ -73,6 +73,8 @@ namespace lsp
 
             public:
                 virtual void                render(ws::ISurface *s, const ws::rectangle_t *area, bool force);
+
+                virtual size_t              affected_layers() const;
         };
     }
 }
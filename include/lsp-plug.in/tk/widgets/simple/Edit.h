@@ -123,6 +123,9 @@ namespace lsp
                 Widget                 *vMenu[4];
 
                 ws::rectangle_t         sTextArea;
+                lltl::darray<float>     vAdvance;       // Cumulative advance of the text for each character position
+                float                   fAdvScaling;    // Font scaling the advances have been computed for
+                bool                    bAdvance;       // Cumulative advances are valid
 
                 prop::String            sText;
                 prop::TextSelection     sSelection;
@@ -151,6 +154,8 @@ namespace lsp
 
             protected:
                 ssize_t                             mouse_to_cursor_pos(ssize_t x, ssize_t y, bool range = true);
+                bool                                sync_advance(float fscaling);
+                inline float                        advance(size_t first, size_t last)  { return *vAdvance.uget(last) - *vAdvance.uget(first);   }
                 void                                run_scroll(ssize_t dir);
                 void                                update_scroll();
                 void                                update_clipboard(size_t bufid);
@@ -66,8 +66,28 @@ namespace lsp
                 AudioChannel(const AudioChannel &);
                 friend class AudioSample;
 
+            protected:
+                enum peak_const_t
+                {
+                    PEAK_BLOCK          = 16,       // Number of samples summarized by the first level of pyramid
+                    PEAK_RATIO          = 4,        // Number of items of the previous level summarized by next level
+                    PEAK_LEVELS         = 12        // Maximum number of levels in the pyramid
+                };
+
+                typedef struct peak_t
+                {
+                    float                   fMin;       // Minimum value
+                    float                   fMax;       // Maximum value
+                    float                   fSqr;       // Sum of squares
+                } peak_t;
+
             protected:
                 prop::FloatArray        vSamples;
+                lltl::darray<peak_t>    vPeaks[PEAK_LEVELS];    // Pyramid of peak values
+                size_t                  nPeakSamples;       // Number of samples the pyramid has been built for
+                float                  *vBuffer;            // Drawing buffer
+                size_t                  nBufSize;           // Size of drawing buffer in floats
+                uint8_t                *pBufData;           // Allocated data for drawing buffer
 
                 prop::Integer           sFadeIn;            // Number of samples for fade-in
                 prop::Integer           sFadeOut;           // Number of samples for fade-out
@@ -85,6 +105,11 @@ namespace lsp
                 prop::SizeConstraints   sConstraints;       // Size constraints
 
             protected:
+                void                    do_destroy();
+                void                    sync_peaks();
+                void                    find_peak(peak_t *p, size_t first, size_t last);
+                float                  *reserve_buffer(size_t size);
+
                 virtual void            size_request(ws::size_limit_t *r);
                 virtual void            property_changed(Property *prop);
 
@@ -96,6 +121,7 @@ namespace lsp
                 virtual ~AudioChannel();
 
                 virtual status_t        init();
+                virtual void            destroy();
 
             public:
                 LSP_TK_PROPERTY(FloatArray,             samples,                &vSamples);
@@ -114,6 +140,21 @@ namespace lsp
                 LSP_TK_PROPERTY(Color,                  line_color,             &sLineColor);
                 LSP_TK_PROPERTY(SizeConstraints,        constraints,            &sConstraints);
 
+            public:
+                /**
+                 * Compute the envelope of the waveform. Each point of the envelope summarizes
+                 * the adjacent range of samples, the number of points is limited by the number
+                 * of samples. The computation time depends on the number of points, not on
+                 * the number of samples.
+                 *
+                 * @param min array to store minimum values, should be of at least points size
+                 * @param max array to store maximum values, should be of at least points size
+                 * @param rms array to store RMS values, can be NULL
+                 * @param points maximum number of points to compute
+                 * @return actual number of computed points
+                 */
+                size_t                  get_envelope(float *min, float *max, float *rms, size_t points);
+
             public:
                 virtual void            draw(ws::ISurface *s);
         };
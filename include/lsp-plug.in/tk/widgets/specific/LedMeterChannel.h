@@ -100,7 +100,20 @@ namespace lsp
                 ws::rectangle_t         sAMeter;            // Meter drawing area
                 ws::rectangle_t         sAText;             // Text drawing area
 
+                ws::ISurface           *pLit;               // Pre-rendered strip of lit segments
+                ws::ISurface           *pUnlit;             // Pre-rendered strip of unlit segments
+                bool                    bSyncStrips;        // Strips need to be rendered again
+                float                   fStripMin;          // Minimum value the strips were rendered for
+                float                   fStripMax;          // Maximum value the strips were rendered for
+                float                   fStripBright;       // Brightness the strips were rendered with
+
             protected:
+                void                        do_destroy();
+                void                        drop_strips();
+                bool                        sync_strips(ws::ISurface *s, ssize_t angle, float scaling, float bright);
+                void                        render_strip(ws::ISurface *s, bool lit, ssize_t angle, float scaling, float bright);
+                static void                 draw_segment(ws::ISurface *s, const lsp::Color *c, float bright, bool lit,
+                                                float x, float y, float w, float h, float scaling);
                 void                        draw_meter(ws::ISurface *s, ssize_t angle, float scaling, float bright);
                 void                        draw_label(ws::ISurface *s, const Font *f, float fscaling, float bright);
                 const lsp::Color           *get_color(float value, const ColorRanges *ranges, const Color *dfl);
@@ -110,8 +123,10 @@ namespace lsp
                 virtual ~LedMeterChannel();
 
                 virtual status_t            init();
+                virtual void                destroy();
 
             protected:
+                virtual void                hide_widget();
                 virtual void                property_changed(Property *prop);
                 virtual void                size_request(ws::size_limit_t *r);
                 virtual void                realize(const ws::rectangle_t *r);
@@ -81,7 +81,22 @@ namespace lsp
             s->set_antialiasing(aa);
         }
 
-        ws::ISurface *create_glass(ws::ISurface **g, ws::ISurface *s,
+        void drop_glass(SurfacePool *pool, ws::ISurface **g)
+        {
+            if ((*g) == NULL)
+                return;
+
+            if (pool != NULL)
+                pool->release(*g);
+            else
+            {
+                (*g)->destroy();
+                delete *g;
+            }
+            (*g)        = NULL;
+        }
+
+        ws::ISurface *create_glass(SurfacePool *pool, ws::ISurface **g, ws::ISurface *s,
                 const lsp::Color &c,
                 size_t mask, ssize_t radius, size_t width, size_t height
         )
@@ -90,18 +105,17 @@ namespace lsp
             if (*g != NULL)
             {
                 if ((width != (*g)->width()) || (height != (*g)->height()))
-                {
-                    (*g)->destroy();
-                    delete *g;
-                    (*g)        = NULL;
-                }
+                    drop_glass(pool, g);
             }
 
             // Create new surface if needed
             if ((*g) != NULL)
                 return *g;
 
-            *g          = (s != NULL) ? s->create(width, height) : NULL;
+            if (pool != NULL)
+                *g          = pool->acquire(s, width, height);
+            else
+                *g          = (s != NULL) ? s->create(width, height) : NULL;
             if ((*g) == NULL)
                 return NULL;
 
@@ -125,7 +139,7 @@ namespace lsp
         }
 
         ws::ISurface * create_border_glass(
-            ws::ISurface **g, ws::ISurface *s,
+            SurfacePool *pool, ws::ISurface **g, ws::ISurface *s,
             const lsp::Color &gc, const lsp::Color &bc,
             size_t mask, ssize_t thick, ssize_t radius,
             size_t width, size_t height, bool flat
@@ -135,18 +149,17 @@ namespace lsp
             if (*g != NULL)
             {
                 if ((width != (*g)->width()) || (height != (*g)->height()))
-                {
-                    (*g)->destroy();
-                    delete *g;
-                    (*g)        = NULL;
-                }
+                    drop_glass(pool, g);
             }
 
             // Create new surface if needed
             if ((*g) != NULL)
                 return *g;
 
-            *g          = (s != NULL) ? s->create(width, height) : NULL;
+            if (pool != NULL)
+                *g          = pool->acquire(s, width, height);
+            else
+                *g          = (s != NULL) ? s->create(width, height) : NULL;
             if ((*g) == NULL)
                 return NULL;
 
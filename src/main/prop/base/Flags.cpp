@@ -57,9 +57,9 @@ namespace lsp
             return STATUS_OK;
         }
 
-        status_t Flags::bind(const char *id, Style *style)
+        status_t Flags::bind(atom_t id, Style *style)
         {
-            if ((style == NULL) || (id == NULL))
+            if ((style == NULL) || (id < 0))
                 return STATUS_BAD_ARGUMENTS;
 
             if (pStyle == style)
@@ -68,40 +68,27 @@ namespace lsp
             // Unbind from previously used style
             unbind();
 
-            LSPString key;
-            if (!key.set_utf8(id))
+            // Obtain the list of atoms resolved once for each property name
+            const atom_t *xatoms = style->schema()->property_atoms(id, pFlags);
+            if (xatoms == NULL)
                 return STATUS_NO_MEM;
-            size_t len = key.length();
 
             // Bind all ports
             status_t res = STATUS_OK;
 
             style->begin();
             {
-                atom_t *atoms = vAtoms;
-                for (const char * const *flags = pFlags; *flags != NULL; ++atoms, ++flags)
+                for (size_t i=0; pFlags[i] != NULL; ++i)
                 {
-                    key.set_length(len);
-                    if (!key.append_ascii(*flags))
-                    {
-                        res = STATUS_NO_MEM;
-                        break;
-                    }
-                    atom_t atom = style->atom_id(key.get_utf8());
-                    if (atom < 0)
-                    {
-                        res = STATUS_NO_MEM;
-                        break;
-                    }
-                    res = style->bind(atom, PT_BOOL, &sListener);
+                    res = style->bind(xatoms[i], PT_BOOL, &sListener);
                     if (res != STATUS_OK)
                         break;
-                    *atoms      = atom;
+                    vAtoms[i]   = xatoms[i];
                 }
 
-                if (res == STATUS_OK)
-                    pStyle      = style;
-                else
+                // Roll back all bindings on error
+                pStyle      = style;
+                if (res != STATUS_OK)
                     unbind();
             }
             style->end();
@@ -115,11 +102,12 @@ namespace lsp
             return res;
         }
 
-        status_t Flags::bind(atom_t id, Style *style)
+        status_t Flags::bind(const char *id, Style *style)
         {
-            if (style == NULL)
+            if ((style == NULL) || (id == NULL))
                 return STATUS_BAD_ARGUMENTS;
-            return bind(style->atom_name(id), style);
+            atom_t atom = style->atom_id(id);
+            return (atom >= 0) ? bind(atom, style) : STATUS_NO_MEM;
         }
 
         status_t Flags::bind(const LSPString *id, Style *style)
@@ -37,6 +37,8 @@ namespace lsp
             if (pStyle == NULL)
                 return STATUS_NOT_BOUND;
 
+            discard_updates();
+
             // Unbind all atoms
             for ( ; desc->postfix != NULL; ++atoms, ++desc)
             {
@@ -50,9 +52,9 @@ namespace lsp
             return STATUS_OK;
         }
 
-        status_t MultiProperty::bind(const char *id, Style *style, atom_t *atoms, const prop::desc_t *desc, IStyleListener *listener)
+        status_t MultiProperty::bind(atom_t id, Style *style, atom_t *atoms, const prop::desc_t *desc, IStyleListener *listener)
         {
-            if ((style == NULL) || (id == NULL))
+            if ((style == NULL) || (id < 0))
                 return STATUS_BAD_ARGUMENTS;
 
             if (pStyle == style)
@@ -61,39 +63,27 @@ namespace lsp
             // Unbind from previously used style
             unbind(atoms, desc, listener);
 
-            LSPString key;
-            if (!key.set_utf8(id))
+            // Obtain the list of atoms resolved once for each property name
+            const atom_t *xatoms = style->schema()->property_atoms(id, desc);
+            if (xatoms == NULL)
                 return STATUS_NO_MEM;
-            size_t len = key.length();
 
             // Bind all ports
             status_t res = STATUS_OK;
 
             style->begin();
             {
-                for ( ; desc->postfix != NULL; ++atoms, ++desc)
+                for (size_t i=0; desc[i].postfix != NULL; ++i)
                 {
-                    key.set_length(len);
-                    if (!key.append_ascii(desc->postfix))
-                    {
-                        res = STATUS_NO_MEM;
-                        break;
-                    }
-                    atom_t atom = style->atom_id(&key);
-                    if (atom < 0)
-                    {
-                        res = STATUS_NO_MEM;
-                        break;
-                    }
-                    res = style->bind(atom, desc->type, listener);
+                    res = style->bind(xatoms[i], desc[i].type, listener);
                     if (res != STATUS_OK)
                         break;
-                    *atoms      = atom;
+                    atoms[i]    = xatoms[i];
                 }
 
-                if (res == STATUS_OK)
-                    pStyle      = style;
-                else
+                // Roll back all bindings on error
+                pStyle      = style;
+                if (res != STATUS_OK)
                     unbind(atoms, desc, listener);
             }
             style->end();
@@ -107,11 +97,12 @@ namespace lsp
             return res;
         }
 
-        status_t MultiProperty::bind(atom_t id, Style *style, atom_t *atoms, const prop::desc_t *desc, IStyleListener *listener)
+        status_t MultiProperty::bind(const char *id, Style *style, atom_t *atoms, const prop::desc_t *desc, IStyleListener *listener)
         {
-            if (style == NULL)
+            if ((style == NULL) || (id == NULL))
                 return STATUS_BAD_ARGUMENTS;
-            return bind(style->atom_name(id), style, atoms, desc, listener);
+            atom_t atom = style->atom_id(id);
+            return (atom >= 0) ? bind(atom, style, atoms, desc, listener) : STATUS_NO_MEM;
         }
 
         status_t MultiProperty::bind(const LSPString *id, Style *style, atom_t *atoms, const prop::desc_t *desc, IStyleListener *listener)
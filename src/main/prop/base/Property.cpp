@@ -75,6 +75,18 @@ namespace lsp
             pStyle->set_override(over);
         }
 
+        void Property::discard_updates()
+        {
+            if (pStyle == NULL)
+                return;
+
+            // Pending updates of the property should not be applied after it has been unbound
+            Schema *schema  = pStyle->schema();
+            Display *dpy    = (schema != NULL) ? schema->display() : NULL;
+            if (dpy != NULL)
+                dpy->updates()->discard(this);
+        }
+
         void Property::sync(bool notify)
         {
             // Push changes to style
@@ -78,6 +78,8 @@ namespace lsp
 
         status_t SimpleProperty::unbind(IStyleListener *listener)
         {
+            discard_updates();
+
             if ((pStyle != NULL) && (nAtom >= 0))
             {
                 status_t res = pStyle->unbind(nAtom, listener);
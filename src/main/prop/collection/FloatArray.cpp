@@ -29,6 +29,7 @@ namespace lsp
         FloatArray::FloatArray(prop::Listener *listener):
             Property(listener)
         {
+            nChanged    = 0;
         }
 
         FloatArray::~FloatArray()
@@ -47,6 +48,7 @@ namespace lsp
                 return;
 
             vItems.clear();
+            nChanged    = 0;
             sync();
         }
 
@@ -59,6 +61,7 @@ namespace lsp
             if (xsize > size)
             {
                 vItems.truncate(size);
+                mark_changed(size);
                 sync();
                 return STATUS_OK;
             }
@@ -69,6 +72,7 @@ namespace lsp
                 return STATUS_NO_MEM;
 
             dsp::fill_zero(v, size);
+            mark_changed(xsize);
             sync();
             return STATUS_OK;
         }
@@ -80,17 +84,20 @@ namespace lsp
                 return STATUS_NO_MEM;
 
             dsp::copy(dst, v, count);
+            nChanged    = 0;
             sync();
             return STATUS_OK;
         }
 
         status_t FloatArray::append(const float *v, size_t count)
         {
+            size_t idx  = vItems.size();
             float *dst  = vItems.append_n(count);
             if (dst == NULL)
                 return STATUS_NO_MEM;
 
             dsp::copy(dst, v, count);
+            mark_changed(idx);
             sync();
             return STATUS_OK;
         }
@@ -102,6 +109,7 @@ namespace lsp
                 return STATUS_NO_MEM;
 
             dsp::copy(dst, v, count);
+            mark_changed(idx);
             sync();
             return STATUS_OK;
         }
@@ -111,6 +119,7 @@ namespace lsp
             if (!vItems.remove_n(idx, count))
                 return STATUS_INVALID_VALUE;
 
+            mark_changed(idx);
             sync();
             return STATUS_OK;
         }
@@ -120,6 +129,7 @@ namespace lsp
             if (!vItems.set_n(count, v))
                 return STATUS_NO_MEM;
 
+            nChanged    = 0;
             sync();
             return STATUS_OK;
         }
@@ -133,6 +143,7 @@ namespace lsp
                 return STATUS_OK;
 
             *xv     = v;
+            mark_changed(idx);
             sync();
             return STATUS_OK;
         }
@@ -142,6 +153,7 @@ namespace lsp
             if (!vItems.set_n(idx, count, v))
                 return STATUS_INVALID_VALUE;
 
+            mark_changed(idx);
             sync();
             return STATUS_OK;
         }
@@ -152,6 +164,8 @@ namespace lsp
                 return;
 
             vItems.swap(src->vItems);
+            nChanged        = 0;
+            src->nChanged   = 0;
             sync();
             src->sync();
         }
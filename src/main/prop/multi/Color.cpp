@@ -36,6 +36,8 @@ namespace lsp
         Color::Color(prop::Listener *listener):
             MultiProperty(vAtoms, P_COUNT, listener)
         {
+            fBright     = 1.0f;
+            bBright     = false;
         }
 
         Color::~Color()
@@ -63,6 +65,7 @@ namespace lsp
         {
             float v;
             lsp::Color &c = sColor;
+            bBright     = false;
 
             if ((property == vAtoms[P_A]) && (pStyle->get_float(vAtoms[P_A], &v) == STATUS_OK))
                 c.alpha(v);
@@ -72,6 +75,19 @@ namespace lsp
                 parse(&c, s, pStyle);
         }
 
+        const lsp::Color *Color::bright_color(float brightness) const
+        {
+            if ((!bBright) || (fBright != brightness))
+            {
+                sBright.copy(sColor);
+                sBright.scale_lch_luminance(brightness);
+                fBright     = brightness;
+                bBright     = true;
+            }
+
+            return &sBright;
+        }
+
         float Color::red(float r)
         {
             float old = sColor.red();
@@ -294,100 +294,26 @@ namespace lsp
             set(f->get_name(), f->get_size(), f->flags());
         }
 
-        bool Font::get_parameters(ws::ISurface *s, float scaling, ws::font_parameters_t *fp) const
-        {
-            if (s == NULL)
-                return false;
-            ws::Font f(&sValue);
-            f.set_size(sValue.size() * lsp_max(0.0f, scaling));
-            return s->get_font_parameters(f, fp);
-        }
-
-        bool Font::get_parameters(Display *dpy, float scaling, ws::font_parameters_t *fp) const
-        {
-            ws::IDisplay *xdpy = (dpy != NULL) ? dpy->display() : NULL;
-            ws::ISurface *s = (xdpy != NULL) ? xdpy->estimation_surface() : NULL;
-            if (s == NULL)
-                return false;
-
-            s->begin();
-            bool res = get_parameters(s, scaling, fp);
-            s->end();
-
-            return res;
-        }
-
-        bool Font::get_multitext_parameters(Display *dpy, ws::text_parameters_t *tp, float scaling, const LSPString *text) const
-        {
-            if (text == NULL)
-                return false;
-            ws::IDisplay *xdpy = (dpy != NULL) ? dpy->display() : NULL;
-            ws::ISurface *s = (xdpy != NULL) ? xdpy->estimation_surface() : NULL;
-            if (s == NULL)
-                return false;
-
-            s->begin();
-            bool res = get_multitext_parameters(s, tp, scaling, text, 0, text->length());
-            s->end();
-
-            return res;
-        }
-
-        bool Font::get_multitext_parameters(Display *dpy, ws::text_parameters_t *tp, float scaling, const LSPString *text, ssize_t first) const
+        TextCache *Font::text_cache(Display *dpy) const
         {
-            if (text == NULL)
-                return false;
-            ws::IDisplay *xdpy = (dpy != NULL) ? dpy->display() : NULL;
-            ws::ISurface *s = (xdpy != NULL) ? xdpy->estimation_surface() : NULL;
-            if (s == NULL)
-                return false;
-
-            s->begin();
-            bool res = get_multitext_parameters(s, tp, scaling, text, first, text->length());
-            s->end();
-
-            return res;
+            if ((dpy == NULL) && (pStyle != NULL))
+                dpy         = pStyle->schema()->display();
+            return (dpy != NULL) ? dpy->text_cache() : NULL;
         }
 
-        bool Font::get_multitext_parameters(Display *dpy, ws::text_parameters_t *tp, float scaling, const LSPString *text, ssize_t first, ssize_t last) const
+        ws::ISurface *Font::estimation_surface(Display *dpy)
         {
-            if (text == NULL)
-                return false;
             ws::IDisplay *xdpy = (dpy != NULL) ? dpy->display() : NULL;
-            ws::ISurface *s = (xdpy != NULL) ? xdpy->estimation_surface() : NULL;
-            if (s == NULL)
-                return false;
-
-            s->begin();
-            bool res = get_multitext_parameters(s, tp, scaling, text, first, last);
-            s->end();
-
-            return res;
-        }
-
-        bool Font::get_multitext_parameters(ws::ISurface *s, ws::text_parameters_t *tp, float scaling, const LSPString *text) const
-        {
-            return (text != NULL) ? get_multitext_parameters(s, tp, scaling, text, 0, text->length()) : false;
-        }
-
-        bool Font::get_multitext_parameters(ws::ISurface *s, ws::text_parameters_t *tp, float scaling, const LSPString *text, ssize_t first) const
-        {
-            return (text != NULL) ? get_multitext_parameters(s, tp, scaling, text, first, text->length()) : false;
+            return (xdpy != NULL) ? xdpy->estimation_surface() : NULL;
         }
 
-        bool Font::get_multitext_parameters(ws::ISurface *s, ws::text_parameters_t *tp, float scaling, const LSPString *text, ssize_t first, ssize_t last) const
+        bool Font::calc_multitext_parameters(ws::ISurface *s, const ws::Font *f, ws::text_parameters_t *tp, const LSPString *text, ssize_t first, ssize_t last) const
         {
-            if ((s == NULL) || (text == NULL))
-                return false;
-
-            ws::Font f(&sValue);
-            f.set_size(sValue.size() * lsp_max(0.0f, scaling));
-
-            ssize_t prev = 0, curr = 0, tail = 0;
+            ssize_t prev = first, curr = first, tail = first;
             ws::font_parameters_t fp;
             ws::text_parameters_t xp, rp;
 
-            if (!s->get_font_parameters(f, &fp))
+            if (!s->get_font_parameters(*f, &fp))
                 return false;
 
             rp.Width        = 0.0f;
@@ -417,10 +343,10 @@ namespace lsp
                 if (str == NULL)
                     return false;
 
-                if (!s->get_text_parameters(f, &xp, str))
+                if (!s->get_text_parameters(*f, &xp, str))
                     return false;
 
-                if (prev <= 0)
+                if (prev <= first)
                 {
                     rp           = xp;
                     rp.Height    = lsp_max(xp.Height, fp.Height);
@@ -441,51 +367,156 @@ namespace lsp
             return true;
         }
 
-        bool Font::get_text_parameters(Display *dpy, ws::text_parameters_t *tp, float scaling, const LSPString *text) const
+        bool Font::get_parameters(ws::ISurface *s, float scaling, ws::font_parameters_t *fp) const
         {
-            if (text == NULL)
+            ws::Font f;
+            get(&f, scaling);
+
+            // Lookup the cache first
+            TextCache *tc   = text_cache(NULL);
+            if ((tc != NULL) && (tc->get_font_parameters(&f, fp)))
+                return true;
+
+            if ((s == NULL) || (!s->get_font_parameters(f, fp)))
                 return false;
-            ws::IDisplay *xdpy = (dpy != NULL) ? dpy->display() : NULL;
-            ws::ISurface *s = (xdpy != NULL) ? xdpy->estimation_surface() : NULL;
+            if (tc != NULL)
+                tc->put_font_parameters(&f, fp);
+
+            return true;
+        }
+
+        bool Font::get_parameters(Display *dpy, float scaling, ws::font_parameters_t *fp) const
+        {
+            ws::Font f;
+            get(&f, scaling);
+
+            // Lookup the cache first
+            TextCache *tc   = text_cache(dpy);
+            if ((tc != NULL) && (tc->get_font_parameters(&f, fp)))
+                return true;
+
+            ws::ISurface *s = estimation_surface(dpy);
             if (s == NULL)
                 return false;
 
             s->begin();
-            bool res = get_text_parameters(s, tp, scaling, text, 0, text->length());
+            bool res = s->get_font_parameters(f, fp);
             s->end();
 
+            if ((res) && (tc != NULL))
+                tc->put_font_parameters(&f, fp);
+
             return res;
         }
 
-        bool Font::get_text_parameters(Display *dpy, ws::text_parameters_t *tp, float scaling, const LSPString *text, ssize_t first) const
+        bool Font::get_multitext_parameters(Display *dpy, ws::text_parameters_t *tp, float scaling, const LSPString *text) const
+        {
+            return (text != NULL) ? get_multitext_parameters(dpy, tp, scaling, text, 0, text->length()) : false;
+        }
+
+        bool Font::get_multitext_parameters(Display *dpy, ws::text_parameters_t *tp, float scaling, const LSPString *text, ssize_t first) const
+        {
+            return (text != NULL) ? get_multitext_parameters(dpy, tp, scaling, text, first, text->length()) : false;
+        }
+
+        bool Font::get_multitext_parameters(Display *dpy, ws::text_parameters_t *tp, float scaling, const LSPString *text, ssize_t first, ssize_t last) const
         {
             if (text == NULL)
                 return false;
-            ws::IDisplay *xdpy = (dpy != NULL) ? dpy->display() : NULL;
-            ws::ISurface *s = (xdpy != NULL) ? xdpy->estimation_surface() : NULL;
+
+            ws::Font f;
+            get(&f, scaling);
+
+            // Lookup the cache first
+            TextCache *tc   = text_cache(dpy);
+            if ((tc != NULL) && (tc->get_multitext_parameters(&f, text->get_utf8(first, last), tp)))
+                return true;
+
+            ws::ISurface *s = estimation_surface(dpy);
             if (s == NULL)
                 return false;
 
             s->begin();
-            bool res = get_text_parameters(s, tp, scaling, text, first, text->length());
+            bool res = calc_multitext_parameters(s, &f, tp, text, first, last);
             s->end();
 
+            // The UTF-8 buffer of the string has been overwritten, obtain the key again
+            if ((res) && (tc != NULL))
+                tc->put_multitext_parameters(&f, text->get_utf8(first, last), tp);
+
             return res;
         }
 
+        bool Font::get_multitext_parameters(ws::ISurface *s, ws::text_parameters_t *tp, float scaling, const LSPString *text) const
+        {
+            return (text != NULL) ? get_multitext_parameters(s, tp, scaling, text, 0, text->length()) : false;
+        }
+
+        bool Font::get_multitext_parameters(ws::ISurface *s, ws::text_parameters_t *tp, float scaling, const LSPString *text, ssize_t first) const
+        {
+            return (text != NULL) ? get_multitext_parameters(s, tp, scaling, text, first, text->length()) : false;
+        }
+
+        bool Font::get_multitext_parameters(ws::ISurface *s, ws::text_parameters_t *tp, float scaling, const LSPString *text, ssize_t first, ssize_t last) const
+        {
+            if (text == NULL)
+                return false;
+
+            ws::Font f;
+            get(&f, scaling);
+
+            // Lookup the cache first
+            TextCache *tc   = text_cache(NULL);
+            if ((tc != NULL) && (tc->get_multitext_parameters(&f, text->get_utf8(first, last), tp)))
+                return true;
+
+            if ((s == NULL) || (!calc_multitext_parameters(s, &f, tp, text, first, last)))
+                return false;
+
+            // The UTF-8 buffer of the string has been overwritten, obtain the key again
+            if (tc != NULL)
+                tc->put_multitext_parameters(&f, text->get_utf8(first, last), tp);
+
+            return true;
+        }
+
+        bool Font::get_text_parameters(Display *dpy, ws::text_parameters_t *tp, float scaling, const LSPString *text) const
+        {
+            return (text != NULL) ? get_text_parameters(dpy, tp, scaling, text, 0, text->length()) : false;
+        }
+
+        bool Font::get_text_parameters(Display *dpy, ws::text_parameters_t *tp, float scaling, const LSPString *text, ssize_t first) const
+        {
+            return (text != NULL) ? get_text_parameters(dpy, tp, scaling, text, first, text->length()) : false;
+        }
+
         bool Font::get_text_parameters(Display *dpy, ws::text_parameters_t *tp, float scaling, const LSPString *text, ssize_t first, ssize_t last) const
         {
             if (text == NULL)
                 return false;
-            ws::IDisplay *xdpy = (dpy != NULL) ? dpy->display() : NULL;
-            ws::ISurface *s = (xdpy != NULL) ? xdpy->estimation_surface() : NULL;
+            const char *str = text->get_utf8(first, last);
+            if (str == NULL)
+                return false;
+
+            ws::Font f;
+            get(&f, scaling);
+
+            // Lookup the cache first
+            TextCache *tc   = text_cache(dpy);
+            if ((tc != NULL) && (tc->get_text_parameters(&f, str, tp)))
+                return true;
+
+            ws::ISurface *s = estimation_surface(dpy);
             if (s == NULL)
                 return false;
 
             s->begin();
-            bool res = get_text_parameters(s, tp, scaling, text, first, last);
+            bool res = s->get_text_parameters(f, tp, str);
             s->end();
 
+            if ((res) && (tc != NULL))
+                tc->put_text_parameters(&f, str, tp);
+
             return res;
         }
 
@@ -501,12 +532,26 @@ namespace lsp
 
         bool Font::get_text_parameters(ws::ISurface *s, ws::text_parameters_t *tp, float scaling, const LSPString *text, ssize_t first, ssize_t last) const
         {
-            if (s == NULL)
+            if (text == NULL)
+                return false;
+            const char *str = text->get_utf8(first, last);
+            if (str == NULL)
                 return false;
 
-            ws::Font f(sValue);
-            f.set_size(sValue.size() * lsp_max(0.0f, scaling)); // Update the font size
-            return s->get_text_parameters(f, tp, text, first, last);
+            ws::Font f;
+            get(&f, scaling);
+
+            // Lookup the cache first
+            TextCache *tc   = text_cache(NULL);
+            if ((tc != NULL) && (tc->get_text_parameters(&f, str, tp)))
+                return true;
+
+            if ((s == NULL) || (!s->get_text_parameters(f, tp, str)))
+                return false;
+            if (tc != NULL)
+                tc->put_text_parameters(&f, str, tp);
+
+            return true;
         }
 
         bool Font::get_text_parameters(ws::ISurface *s, ws::text_parameters_t *tp, float scaling, const char *text) const
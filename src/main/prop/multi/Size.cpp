@@ -190,6 +190,28 @@ namespace lsp
             return (r->nWidth <= 0) || (r->nHeight <= 0);
         }
 
+        bool Size::inside(const ws::rectangle_t *a, const ws::rectangle_t *b)
+        {
+            // Check that B lies entirely within A
+            return  (b->nLeft >= a->nLeft) &&
+                    (b->nTop >= a->nTop) &&
+                    ((b->nLeft + b->nWidth) <= (a->nLeft + a->nWidth)) &&
+                    ((b->nTop + b->nHeight) <= (a->nTop + a->nHeight));
+        }
+
+        void Size::bounds(ws::rectangle_t *dst, const ws::rectangle_t *a, const ws::rectangle_t *b)
+        {
+            ssize_t left    = lsp_min(a->nLeft, b->nLeft);
+            ssize_t top     = lsp_min(a->nTop, b->nTop);
+            ssize_t right   = lsp_max(a->nLeft + a->nWidth, b->nLeft + b->nWidth);
+            ssize_t bottom  = lsp_max(a->nTop + a->nHeight, b->nTop + b->nHeight);
+
+            dst->nLeft      = left;
+            dst->nTop       = top;
+            dst->nWidth     = right - left;
+            dst->nHeight    = bottom - top;
+        }
+
         void Size::init(ws::rectangle_t *dst, ssize_t left, ssize_t top, ssize_t width, ssize_t height)
         {
             dst->nLeft          = left;
@@ -485,6 +485,16 @@ namespace lsp
                 dst->nPreHeight = lsp_max(0, ceilf(dst->nPreHeight * scale));
         }
 
+        bool SizeConstraints::equals(const ws::size_limit_t *a, const ws::size_limit_t *b)
+        {
+            return  (a->nMinWidth   == b->nMinWidth) &&
+                    (a->nMinHeight  == b->nMinHeight) &&
+                    (a->nMaxWidth   == b->nMaxWidth) &&
+                    (a->nMaxHeight  == b->nMaxHeight) &&
+                    (a->nPreWidth   == b->nPreWidth) &&
+                    (a->nPreHeight  == b->nPreHeight);
+        }
+
     } /* namespace tk */
 } /* namespace lsp */
 
@@ -0,0 +1,746 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-tk-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-tk-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-tk-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-tk-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <lsp-plug.in/tk/tk.h>
+#include <lsp-plug.in/lltl/darray.h>
+#include <lsp-plug.in/lltl/parray.h>
+#include <lsp-plug.in/lltl/pphash.h>
+#include <lsp-plug.in/io/OutFile.h>
+#include <lsp-plug.in/common/debug.h>
+
+#ifdef PLATFORM_WINDOWS
+    #include <lsp-plug.in/io/InFile.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <errno.h>
+    #include <stdio.h>
+#endif /* PLATFORM_WINDOWS */
+
+#define IMAGE_ALIGN         8
+#define IMAGE_READ_CHUNK    0x10000
+
+namespace lsp
+{
+    namespace tk
+    {
+        struct CompiledStyleSheet::compiler_t
+        {
+            typedef struct intern_t
+            {
+                uint32_t            index;          // Index of the interned string
+            } intern_t;
+
+            lltl::pphash<LSPString, intern_t>               vIndex;     // Index of interned strings
+            lltl::parray<intern_t>                          vInterns;   // Allocated interned strings
+            lltl::darray<string_t>                          vStrings;
+            lltl::darray<char>                              vChars;
+            lltl::darray<color_t>                           vColors;
+            lltl::darray<font_t>                            vFonts;
+            lltl::darray<style_t>                           vStyles;
+            lltl::darray<uint32_t>                          vParents;
+            lltl::darray<prop_t>                            vProps;
+
+            ~compiler_t()
+            {
+                vIndex.flush();
+                for (size_t i=0, n=vInterns.size(); i<n; ++i)
+                {
+                    intern_t *it = vInterns.uget(i);
+                    if (it != NULL)
+                        delete it;
+                }
+                vInterns.flush();
+            }
+        };
+
+        CompiledStyleSheet::CompiledStyleSheet()
+        {
+            pData       = NULL;
+            nSize       = 0;
+            nStorage    = M_NONE;
+            pHeader     = NULL;
+            vStrings    = NULL;
+            vChars      = NULL;
+            vColors     = NULL;
+            vFonts      = NULL;
+            vStyles     = NULL;
+            vParents    = NULL;
+            vProps      = NULL;
+        }
+
+        CompiledStyleSheet::~CompiledStyleSheet()
+        {
+            close();
+        }
+
+        void CompiledStyleSheet::close()
+        {
+            free_image(pData, nSize, nStorage);
+
+            pData       = NULL;
+            nSize       = 0;
+            nStorage    = M_NONE;
+            pHeader     = NULL;
+            vStrings    = NULL;
+            vChars      = NULL;
+            vColors     = NULL;
+            vFonts      = NULL;
+            vStyles     = NULL;
+            vParents    = NULL;
+            vProps      = NULL;
+        }
+
+        void CompiledStyleSheet::free_image(uint8_t *data, size_t size, size_t storage)
+        {
+            if (data == NULL)
+                return;
+
+            switch (storage)
+            {
+                case M_HEAP:
+                    ::free(data);
+                    break;
+            #ifndef PLATFORM_WINDOWS
+                case M_MMAP:
+                    ::munmap(data, size);
+                    break;
+            #endif /* PLATFORM_WINDOWS */
+                default:
+                    break;
+            }
+        }
+
+        uint64_t CompiledStyleSheet::checksum(const LSPString *text)
+        {
+            // FNV-1a hash over all characters of the document
+            uint64_t hash   = 0xcbf29ce484222325ULL;
+            for (size_t i=0, n=text->length(); i<n; ++i)
+            {
+                uint32_t ch     = text->char_at(i);
+                for (size_t j=0; j<4; ++j, ch >>= 8)
+                {
+                    hash           ^= (ch & 0xff);
+                    hash           *= 0x100000001b3ULL;
+                }
+            }
+
+            return hash;
+        }
+
+        status_t CompiledStyleSheet::intern(compiler_t *c, const LSPString *s, uint32_t *id)
+        {
+            // Lookup for existing string
+            compiler_t::intern_t *it = c->vIndex.get(s);
+            if (it != NULL)
+            {
+                *id             = it->index;
+                return STATUS_OK;
+            }
+
+            // Add string data
+            const char *utf8    = s->get_utf8();
+            if (utf8 == NULL)
+                return STATUS_NO_MEM;
+            size_t len          = ::strlen(utf8);
+
+            string_t *str       = c->vStrings.add();
+            if (str == NULL)
+                return STATUS_NO_MEM;
+            str->offset         = c->vChars.size();
+            str->length         = len;
+
+            char *dst           = c->vChars.append_n(len + 1);
+            if (dst == NULL)
+                return STATUS_NO_MEM;
+            ::memcpy(dst, utf8, len + 1);
+
+            // Register string in the index
+            if ((it = new compiler_t::intern_t) == NULL)
+                return STATUS_NO_MEM;
+            it->index           = c->vStrings.size() - 1;
+            if (!c->vInterns.add(it))
+            {
+                delete it;
+                return STATUS_NO_MEM;
+            }
+            if (!c->vIndex.create(s, it))
+                return STATUS_NO_MEM;
+
+            *id                 = it->index;
+            return STATUS_OK;
+        }
+
+        ssize_t CompiledStyleSheet::cmp_names(const LSPString *a, const LSPString *b)
+        {
+            return a->compare_to(b);
+        }
+
+        status_t CompiledStyleSheet::emit_style(compiler_t *c, const StyleSheet::style_t *s)
+        {
+            status_t res;
+            style_t xs;
+
+            // Emit parents
+            if ((res = intern(c, &s->name, &xs.name)) != STATUS_OK)
+                return res;
+            xs.parent           = c->vParents.size();
+            xs.parents          = s->parents.size();
+
+            for (size_t i=0; i<xs.parents; ++i)
+            {
+                uint32_t *id        = c->vParents.add();
+                if (id == NULL)
+                    return STATUS_NO_MEM;
+                if ((res = intern(c, s->parents.uget(i), id)) != STATUS_OK)
+                    return res;
+            }
+
+            // Emit properties in the order of names
+            lltl::parray<LSPString> names;
+            if (!s->properties.keys(&names))
+                return STATUS_NO_MEM;
+            names.qsort(cmp_names);
+
+            xs.prop             = c->vProps.size();
+            xs.props            = names.size();
+
+            Schema::property_value_t v;
+            for (size_t i=0; i<xs.props; ++i)
+            {
+                const LSPString *name   = names.uget(i);
+                const LSPString *value  = s->properties.get(name);
+                if (value == NULL)
+                    return STATUS_BAD_STATE;
+
+                prop_t *p           = c->vProps.add();
+                if (p == NULL)
+                    return STATUS_NO_MEM;
+                ::bzero(p, sizeof(prop_t));
+
+                if ((res = intern(c, name, &p->name)) != STATUS_OK)
+                    return res;
+                if ((res = intern(c, value, &p->text)) != STATUS_OK)
+                    return res;
+
+                // Pre-parse the value the same way as it is done for untyped properties
+                if (Schema::parse_property_value(&v, value, PT_UNKNOWN) != STATUS_OK)
+                {
+                    v.type              = PT_STRING;
+                    p->flags           |= P_TEXT_ONLY;
+                }
+
+                p->type             = v.type;
+                switch (v.type)
+                {
+                    case PT_BOOL:   p->bvalue   = (v.bvalue) ? 1 : 0;   break;
+                    case PT_INT:    p->ivalue   = v.ivalue;             break;
+                    case PT_FLOAT:  p->fvalue   = v.fvalue;             break;
+                    default:        p->type     = PT_STRING;            break;
+                }
+            }
+
+            return (c->vStyles.add(&xs)) ? STATUS_OK : STATUS_NO_MEM;
+        }
+
+        status_t CompiledStyleSheet::compile(const StyleSheet *sheet, uint64_t checksum)
+        {
+            if (sheet == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            status_t res;
+            compiler_t c;
+            uint32_t title = F_NONE;
+            size_t flags = 0;
+
+            if (!sheet->sTitle.is_empty())
+            {
+                if ((res = intern(&c, &sheet->sTitle, &title)) != STATUS_OK)
+                    return res;
+            }
+
+            // Emit colors
+            lltl::parray<LSPString> names;
+            if (!sheet->vColors.keys(&names))
+                return STATUS_NO_MEM;
+            names.qsort(cmp_names);
+
+            for (size_t i=0, n=names.size(); i<n; ++i)
+            {
+                const LSPString *name   = names.uget(i);
+                const lsp::Color *color = sheet->vColors.get(name);
+                if (color == NULL)
+                    return STATUS_BAD_STATE;
+
+                color_t *xc         = c.vColors.add();
+                if (xc == NULL)
+                    return STATUS_NO_MEM;
+                if ((res = intern(&c, name, &xc->name)) != STATUS_OK)
+                    return res;
+                xc->r               = color->red();
+                xc->g               = color->green();
+                xc->b               = color->blue();
+                xc->a               = color->alpha();
+            }
+
+            // Emit fonts
+            names.clear();
+            if (!sheet->vFonts.keys(&names))
+                return STATUS_NO_MEM;
+            names.qsort(cmp_names);
+
+            for (size_t i=0, n=names.size(); i<n; ++i)
+            {
+                const StyleSheet::font_t *font  = sheet->vFonts.get(names.uget(i));
+                if (font == NULL)
+                    return STATUS_BAD_STATE;
+
+                font_t *xf          = c.vFonts.add();
+                if (xf == NULL)
+                    return STATUS_NO_MEM;
+                if ((res = intern(&c, &font->name, &xf->name)) != STATUS_OK)
+                    return res;
+                if ((res = intern(&c, &font->path, &xf->path)) != STATUS_OK)
+                    return res;
+                xf->alias           = (font->alias) ? 1 : 0;
+            }
+
+            // Emit root style first and then all other styles in the order of inheritance
+            if (sheet->pRoot != NULL)
+            {
+                if ((res = emit_style(&c, sheet->pRoot)) != STATUS_OK)
+                    return res;
+                flags              |= F_ROOT;
+            }
+
+            if (sheet->vOrder.size() != sheet->vStyles.size())
+                return STATUS_BAD_STATE;
+            for (size_t i=0, n=sheet->vOrder.size(); i<n; ++i)
+            {
+                if ((res = emit_style(&c, sheet->vOrder.uget(i))) != STATUS_OK)
+                    return res;
+            }
+
+            // Compute the layout of the image
+            section_t sections[7];
+            const size_t sizes[7] =
+            {
+                sizeof(string_t), sizeof(char), sizeof(color_t), sizeof(font_t),
+                sizeof(style_t), sizeof(uint32_t), sizeof(prop_t)
+            };
+            const void *items[7] =
+            {
+                c.vStrings.array(), c.vChars.array(), c.vColors.array(), c.vFonts.array(),
+                c.vStyles.array(), c.vParents.array(), c.vProps.array()
+            };
+            sections[0].count   = c.vStrings.size();
+            sections[1].count   = c.vChars.size();
+            sections[2].count   = c.vColors.size();
+            sections[3].count   = c.vFonts.size();
+            sections[4].count   = c.vStyles.size();
+            sections[5].count   = c.vParents.size();
+            sections[6].count   = c.vProps.size();
+
+            size_t size         = align_size(sizeof(header_t), IMAGE_ALIGN);
+            for (size_t i=0; i<7; ++i)
+            {
+                sections[i].offset  = size;
+                size               += align_size(sections[i].count * sizes[i], IMAGE_ALIGN);
+            }
+            if (size > 0xffffffffU)
+                return STATUS_OVERFLOW;
+
+            // Build the image
+            uint8_t *data       = static_cast<uint8_t *>(::malloc(size));
+            if (data == NULL)
+                return STATUS_NO_MEM;
+            ::bzero(data, size);
+
+            header_t *hdr       = reinterpret_cast<header_t *>(data);
+            hdr->magic          = F_MAGIC;
+            hdr->version        = F_VERSION;
+            hdr->size           = size;
+            hdr->flags          = flags;
+            hdr->checksum       = checksum;
+            hdr->title          = title;
+            hdr->reserved       = 0;
+            hdr->strings        = sections[0];
+            hdr->chars          = sections[1];
+            hdr->colors         = sections[2];
+            hdr->fonts          = sections[3];
+            hdr->styles         = sections[4];
+            hdr->parents        = sections[5];
+            hdr->props          = sections[6];
+
+            for (size_t i=0; i<7; ++i)
+            {
+                if (sections[i].count > 0)
+                    ::memcpy(&data[sections[i].offset], items[i], sections[i].count * sizes[i]);
+            }
+
+            // Replace current image
+            if ((res = bind_image(data, size, M_HEAP)) != STATUS_OK)
+                free_image(data, size, M_HEAP);
+
+            return res;
+        }
+
+        status_t CompiledStyleSheet::validate(const uint8_t *data, size_t size)
+        {
+            if ((data == NULL) || (size < sizeof(header_t)))
+                return STATUS_CORRUPTED;
+
+            const header_t *hdr = reinterpret_cast<const header_t *>(data);
+            if (hdr->magic != F_MAGIC)
+                return STATUS_BAD_FORMAT;
+            if (hdr->version != F_VERSION)
+                return STATUS_BAD_FORMAT;
+            if (hdr->size != size)
+                return STATUS_CORRUPTED;
+
+            // Validate sections
+            const section_t *sections[7] =
+            {
+                &hdr->strings, &hdr->chars, &hdr->colors, &hdr->fonts,
+                &hdr->styles, &hdr->parents, &hdr->props
+            };
+            const size_t sizes[7] =
+            {
+                sizeof(string_t), sizeof(char), sizeof(color_t), sizeof(font_t),
+                sizeof(style_t), sizeof(uint32_t), sizeof(prop_t)
+            };
+
+            for (size_t i=0; i<7; ++i)
+            {
+                const section_t *s  = sections[i];
+                if ((s->offset < sizeof(header_t)) || (s->offset % IMAGE_ALIGN))
+                    return STATUS_CORRUPTED;
+                if (uint64_t(s->offset) + uint64_t(s->count) * sizes[i] > size)
+                    return STATUS_CORRUPTED;
+            }
+
+            // Validate strings
+            const string_t *strings = reinterpret_cast<const string_t *>(&data[hdr->strings.offset]);
+            const char *chars       = reinterpret_cast<const char *>(&data[hdr->chars.offset]);
+            const size_t nstrings   = hdr->strings.count;
+
+            for (size_t i=0; i<nstrings; ++i)
+            {
+                const string_t *s   = &strings[i];
+                if (uint64_t(s->offset) + s->length >= hdr->chars.count)
+                    return STATUS_CORRUPTED;
+                if (chars[s->offset + s->length] != '\0')
+                    return STATUS_CORRUPTED;
+            }
+            if ((hdr->title != F_NONE) && (hdr->title >= nstrings))
+                return STATUS_CORRUPTED;
+
+            // Validate colors and fonts
+            const color_t *colors   = reinterpret_cast<const color_t *>(&data[hdr->colors.offset]);
+            for (size_t i=0, n=hdr->colors.count; i<n; ++i)
+            {
+                if (colors[i].name >= nstrings)
+                    return STATUS_CORRUPTED;
+            }
+
+            const font_t *fonts     = reinterpret_cast<const font_t *>(&data[hdr->fonts.offset]);
+            for (size_t i=0, n=hdr->fonts.count; i<n; ++i)
+            {
+                if ((fonts[i].name >= nstrings) || (fonts[i].path >= nstrings))
+                    return STATUS_CORRUPTED;
+            }
+
+            // Validate styles, parents and properties
+            if ((hdr->flags & F_ROOT) && (hdr->styles.count <= 0))
+                return STATUS_CORRUPTED;
+
+            const style_t *styles   = reinterpret_cast<const style_t *>(&data[hdr->styles.offset]);
+            for (size_t i=0, n=hdr->styles.count; i<n; ++i)
+            {
+                const style_t *s    = &styles[i];
+                if (s->name >= nstrings)
+                    return STATUS_CORRUPTED;
+                if (uint64_t(s->parent) + s->parents > hdr->parents.count)
+                    return STATUS_CORRUPTED;
+                if (uint64_t(s->prop) + s->props > hdr->props.count)
+                    return STATUS_CORRUPTED;
+            }
+
+            const uint32_t *parents = reinterpret_cast<const uint32_t *>(&data[hdr->parents.offset]);
+            for (size_t i=0, n=hdr->parents.count; i<n; ++i)
+            {
+                if (parents[i] >= nstrings)
+                    return STATUS_CORRUPTED;
+            }
+
+            const prop_t *props     = reinterpret_cast<const prop_t *>(&data[hdr->props.offset]);
+            for (size_t i=0, n=hdr->props.count; i<n; ++i)
+            {
+                const prop_t *p     = &props[i];
+                if ((p->name >= nstrings) || (p->text >= nstrings))
+                    return STATUS_CORRUPTED;
+                switch (p->type)
+                {
+                    case PT_INT:
+                    case PT_FLOAT:
+                    case PT_BOOL:
+                    case PT_STRING:
+                        break;
+                    default:
+                        return STATUS_CORRUPTED;
+                }
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t CompiledStyleSheet::bind_image(uint8_t *data, size_t size, size_t storage)
+        {
+            status_t res = validate(data, size);
+            if (res != STATUS_OK)
+                return res;
+
+            // Drop previous image and bind the new one
+            close();
+
+            const header_t *hdr = reinterpret_cast<const header_t *>(data);
+
+            pData       = data;
+            nSize       = size;
+            nStorage    = storage;
+            pHeader     = hdr;
+            vStrings    = reinterpret_cast<const string_t *>(&data[hdr->strings.offset]);
+            vChars      = reinterpret_cast<const char *>(&data[hdr->chars.offset]);
+            vColors     = reinterpret_cast<const color_t *>(&data[hdr->colors.offset]);
+            vFonts      = reinterpret_cast<const font_t *>(&data[hdr->fonts.offset]);
+            vStyles     = reinterpret_cast<const style_t *>(&data[hdr->styles.offset]);
+            vParents    = reinterpret_cast<const uint32_t *>(&data[hdr->parents.offset]);
+            vProps      = reinterpret_cast<const prop_t *>(&data[hdr->props.offset]);
+
+            return STATUS_OK;
+        }
+
+        status_t CompiledStyleSheet::load(const char *path)
+        {
+            LSPString tmp;
+            if (!tmp.set_utf8(path))
+                return STATUS_NO_MEM;
+            return load(&tmp);
+        }
+
+        status_t CompiledStyleSheet::load(const io::Path *path)
+        {
+            return load(path->as_string());
+        }
+
+        status_t CompiledStyleSheet::load(const LSPString *path)
+        {
+            uint8_t *data   = NULL;
+            size_t size     = 0;
+            size_t storage  = M_NONE;
+
+            status_t res    = load_file(path, &data, &size, &storage);
+            if (res != STATUS_OK)
+                return res;
+
+            if ((res = bind_image(data, size, storage)) != STATUS_OK)
+                free_image(data, size, storage);
+
+            return res;
+        }
+
+    #ifdef PLATFORM_WINDOWS
+        status_t CompiledStyleSheet::load_file(const LSPString *path, uint8_t **data, size_t *size, size_t *storage)
+        {
+            io::InFile is;
+            status_t res = is.open(path);
+            if (res != STATUS_OK)
+                return res;
+
+            // Read the whole file into memory
+            uint8_t *buf    = NULL;
+            size_t len      = 0;
+
+            while (true)
+            {
+                uint8_t *xbuf   = static_cast<uint8_t *>(::realloc(buf, len + IMAGE_READ_CHUNK));
+                if (xbuf == NULL)
+                {
+                    res             = STATUS_NO_MEM;
+                    break;
+                }
+                buf             = xbuf;
+
+                ssize_t n       = is.read(&buf[len], IMAGE_READ_CHUNK);
+                if (n <= 0)
+                {
+                    res             = ((n == 0) || (n == -STATUS_EOF)) ? STATUS_OK : status_t(-n);
+                    break;
+                }
+                len            += n;
+            }
+
+            is.close();
+            if ((res == STATUS_OK) && (len <= 0))
+                res             = STATUS_CORRUPTED;
+            if (res != STATUS_OK)
+            {
+                if (buf != NULL)
+                    ::free(buf);
+                return res;
+            }
+
+            *data           = buf;
+            *size           = len;
+            *storage        = M_HEAP;
+
+            return STATUS_OK;
+        }
+    #else
+        status_t CompiledStyleSheet::load_file(const LSPString *path, uint8_t **data, size_t *size, size_t *storage)
+        {
+            const char *native = path->get_native();
+            if (native == NULL)
+                return STATUS_NO_MEM;
+
+            int fd = ::open(native, O_RDONLY);
+            if (fd < 0)
+                return (errno == ENOENT) ? STATUS_NOT_FOUND : STATUS_IO_ERROR;
+
+            // Map the whole file into memory
+            struct stat st;
+            if (::fstat(fd, &st) != 0)
+            {
+                ::close(fd);
+                return STATUS_IO_ERROR;
+            }
+            if ((st.st_size < ssize_t(sizeof(header_t))) || (st.st_size > 0xffffffffLL))
+            {
+                ::close(fd);
+                return STATUS_CORRUPTED;
+            }
+
+            void *addr = ::mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (addr == MAP_FAILED)
+                return STATUS_IO_ERROR;
+
+            *data           = static_cast<uint8_t *>(addr);
+            *size           = st.st_size;
+            *storage        = M_MMAP;
+
+            return STATUS_OK;
+        }
+    #endif /* PLATFORM_WINDOWS */
+
+        status_t CompiledStyleSheet::save(const char *path) const
+        {
+            LSPString tmp;
+            if (!tmp.set_utf8(path))
+                return STATUS_NO_MEM;
+            return save(&tmp);
+        }
+
+        status_t CompiledStyleSheet::save(const io::Path *path) const
+        {
+            return save(path->as_string());
+        }
+
+        status_t CompiledStyleSheet::save(const LSPString *path) const
+        {
+            if (pHeader == NULL)
+                return STATUS_BAD_STATE;
+
+        #ifdef PLATFORM_WINDOWS
+            status_t res    = write_file(path);
+        #else
+            // Other processes may have the file mapped into memory,
+            // so write a temporary file and replace the original one
+            LSPString tmp;
+            if ((!tmp.set(path)) || (!tmp.append_ascii(".tmp")))
+                return STATUS_NO_MEM;
+
+            status_t res    = write_file(&tmp);
+            if (res == STATUS_OK)
+            {
+                if (::rename(tmp.get_native(), path->get_native()) != 0)
+                {
+                    ::unlink(tmp.get_native());
+                    res         = STATUS_IO_ERROR;
+                }
+            }
+        #endif /* PLATFORM_WINDOWS */
+
+            return res;
+        }
+
+        status_t CompiledStyleSheet::write_file(const LSPString *path) const
+        {
+            io::OutFile os;
+            status_t res = os.open(path, io::File::FM_WRITE_NEW);
+            if (res != STATUS_OK)
+                return res;
+
+            ssize_t written = os.write(pData, nSize);
+            res = (written < 0) ? status_t(-written) :
+                  (size_t(written) != nSize) ? STATUS_IO_ERROR : STATUS_OK;
+
+            status_t xres = os.close();
+            return (res != STATUS_OK) ? res : xres;
+        }
+
+        const char *CompiledStyleSheet::title() const
+        {
+            if ((pHeader == NULL) || (pHeader->title == F_NONE))
+                return NULL;
+            return string(pHeader->title);
+        }
+
+        size_t CompiledStyleSheet::styles() const
+        {
+            return (pHeader != NULL) ? pHeader->styles.count : 0;
+        }
+
+        const char *CompiledStyleSheet::style_name(size_t index) const
+        {
+            if ((pHeader == NULL) || (index >= pHeader->styles.count))
+                return NULL;
+            return string(vStyles[index].name);
+        }
+
+        ssize_t CompiledStyleSheet::index_of(const char *style) const
+        {
+            if ((pHeader == NULL) || (style == NULL))
+                return -STATUS_NOT_FOUND;
+
+            for (size_t i=0, n=pHeader->styles.count; i<n; ++i)
+            {
+                if (!::strcmp(string(vStyles[i].name), style))
+                    return i;
+            }
+
+            return -STATUS_NOT_FOUND;
+        }
+    }
+}
@@ -85,6 +85,9 @@ namespace lsp
 
             // Destroy colors
             destroy_colors();
+
+            // Destroy cached property atoms
+            destroy_prop_atoms();
         }
 
         void Schema::destroy_colors()
@@ -104,6 +107,21 @@ namespace lsp
             }
         }
 
+        void Schema::destroy_prop_atoms()
+        {
+            for (size_t i=0, n=vPropAtoms.size(); i<n; ++i)
+            {
+                prop_atoms_t *pa = *(vPropAtoms.uget(i));
+                while (pa != NULL)
+                {
+                    prop_atoms_t *next = pa->pNext;
+                    ::free(pa);
+                    pa      = next;
+                }
+            }
+            vPropAtoms.flush();
+        }
+
         status_t Schema::init_colors_from_sheet(const StyleSheet *sheet)
         {
             lltl::parray<LSPString> vk;
@@ -129,85 +147,125 @@ namespace lsp
             return STATUS_OK;
         }
 
-        status_t Schema::load_fonts_from_sheet(const StyleSheet *sheet, resource::ILoader *loader)
+        status_t Schema::init_colors_from_sheet(const CompiledStyleSheet *sheet)
         {
-            status_t res;
-            lltl::parray<LSPString> vk;
-            sheet->enum_fonts(&vk);
+            LSPString key;
+            for (size_t i=0, n=sheet->pHeader->colors.count; i<n; ++i)
+            {
+                const CompiledStyleSheet::color_t *c = &sheet->vColors[i];
+                if (!key.set_utf8(sheet->string(c->name)))
+                    return STATUS_NO_MEM;
+
+                lsp::Color *xc      = new lsp::Color();
+                if (xc == NULL)
+                    return STATUS_NO_MEM;
+                xc->set_rgba(c->r, c->g, c->b, c->a);
+
+                if (!vColors.create(&key, xc))
+                {
+                    delete xc;
+                    return STATUS_NO_MEM;
+                }
+            }
 
+            return STATUS_OK;
+        }
+
+        status_t Schema::load_font(const char *name, const char *path, bool alias, resource::ILoader *loader)
+        {
+            status_t res;
             ws::IDisplay *dpy = pDisplay->display();
             if (dpy == NULL)
                 return STATUS_BAD_STATE;
 
-            for (size_t i=0, n=vk.size(); i<n; ++i)
+            if (alias)
             {
-                LSPString *key              = vk.uget(i);
-                StyleSheet::font_t *font    = sheet->vFonts.get(key);
-                if ((key == NULL) || (font == NULL))
-                    return STATUS_BAD_STATE;
-
-                if (font->alias)
+                if ((res = dpy->add_font_alias(name, path)) != STATUS_OK)
                 {
-                    if ((res = dpy->add_font_alias(font->name.get_utf8(), font->path.get_utf8())) != STATUS_OK)
-                    {
-                        lsp_error("Could not create font alias \"%s\" -> \"%s\"",
-                            font->name.get_utf8(),
-                            font->path.get_utf8()
-                        );
-                        return res;
-                    }
+                    lsp_error("Could not create font alias \"%s\" -> \"%s\"", name, path);
+                    return res;
                 }
-                else if ((loader != NULL) || (pDisplay->pResourceLoader != NULL))
-                {
-                    // Patch the loader (if not specified)
-                    if (loader == NULL)
-                        loader  = pDisplay->pResourceLoader;
-
-                    // Use resource resolver for loading fonts
-                    io::IInStream *is = loader->read_stream(&font->path);
-                    if (is == NULL)
-                    {
-                        lsp_error("Could not resolve font data \"%s\" located at \"%s\", error code %d",
-                            font->name.get_utf8(),
-                            font->path.get_utf8(),
-                            int(loader->last_error())
-                        );
-                        return loader->last_error();
-                    }
+            }
+            else if ((loader != NULL) || (pDisplay->pResourceLoader != NULL))
+            {
+                // Patch the loader (if not specified)
+                if (loader == NULL)
+                    loader  = pDisplay->pResourceLoader;
 
-                    if ((res = dpy->add_font(font->name.get_utf8(), is)) != STATUS_OK)
-                    {
-                        lsp_error("Could not load font data \"%s\" resolved at \"%s\", error code %d",
-                            font->name.get_utf8(),
-                            font->path.get_utf8(),
-                            int(loader->last_error())
-                        );
-                        is->close();
-                        delete is;
-                        return res;
-                    }
+                // Use resource resolver for loading fonts
+                io::IInStream *is = loader->read_stream(path);
+                if (is == NULL)
+                {
+                    lsp_error("Could not resolve font data \"%s\" located at \"%s\", error code %d",
+                        name, path, int(loader->last_error())
+                    );
+                    return loader->last_error();
+                }
 
+                if ((res = dpy->add_font(name, is)) != STATUS_OK)
+                {
+                    lsp_error("Could not load font data \"%s\" resolved at \"%s\", error code %d",
+                        name, path, int(loader->last_error())
+                    );
                     is->close();
                     delete is;
+                    return res;
                 }
-                else
+
+                is->close();
+                delete is;
+            }
+            else
+            {
+                // Just load font from file
+                if ((res = dpy->add_font(name, path)) != STATUS_OK)
                 {
-                    // Just load font from file
-                    if ((res = dpy->add_font(font->name.get_utf8(), font->path.get_utf8())) != STATUS_OK)
-                    {
-                        lsp_error("Could not load font \"%s\" located at \"%s\", error code %d",
-                            font->name.get_utf8(),
-                            font->path.get_utf8(),
-                            int(res)
-                        );
-                        return res;
-                    }
+                    lsp_error("Could not load font \"%s\" located at \"%s\", error code %d",
+                        name, path, int(res)
+                    );
+                    return res;
                 }
             }
 
             return STATUS_OK;
         }
 
+        status_t Schema::load_fonts_from_sheet(const StyleSheet *sheet, resource::ILoader *loader)
+        {
+            status_t res;
+            lltl::parray<LSPString> vk;
+            sheet->enum_fonts(&vk);
+
+            for (size_t i=0, n=vk.size(); i<n; ++i)
+            {
+                LSPString *key              = vk.uget(i);
+                StyleSheet::font_t *font    = sheet->vFonts.get(key);
+                if ((key == NULL) || (font == NULL))
+                    return STATUS_BAD_STATE;
+
+                res = load_font(font->name.get_utf8(), font->path.get_utf8(), font->alias, loader);
+                if (res != STATUS_OK)
+                    return res;
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t Schema::load_fonts_from_sheet(const CompiledStyleSheet *sheet, resource::ILoader *loader)
+        {
+            status_t res;
+
+            for (size_t i=0, n=sheet->pHeader->fonts.count; i<n; ++i)
+            {
+                const CompiledStyleSheet::font_t *font = &sheet->vFonts[i];
+                res = load_font(sheet->string(font->name), sheet->string(font->path), font->alias, loader);
+                if (res != STATUS_OK)
+                    return res;
+            }
+
+            return STATUS_OK;
+        }
+
         status_t Schema::init(lltl::parray<IStyleFactory> *list)
         {
             return init(list->array(), list->size());
@@ -294,12 +352,31 @@ namespace lsp
             if (sheet == NULL)
                 return STATUS_BAD_ARGUMENTS;
 
-            // Apply settings in configuration mode
+            // Apply settings in configuration mode, deliver notifications when all is done
             nFlags |= S_CONFIGURING;
-            status_t res = apply_internal(sheet, loader);
+            status_t res = lock_styles();
+            if (res == STATUS_OK)
+                res = apply_internal(sheet, loader);
+            status_t xres = unlock_styles();
             nFlags &= ~S_CONFIGURING;
 
-            return res;
+            return (res != STATUS_OK) ? res : xres;
+        }
+
+        status_t Schema::apply(const CompiledStyleSheet *sheet, resource::ILoader *loader)
+        {
+            if ((sheet == NULL) || (!sheet->is_valid()))
+                return STATUS_BAD_ARGUMENTS;
+
+            // Apply settings in configuration mode, deliver notifications when all is done
+            nFlags |= S_CONFIGURING;
+            status_t res = lock_styles();
+            if (res == STATUS_OK)
+                res = apply_internal(sheet, loader);
+            status_t xres = unlock_styles();
+            nFlags &= ~S_CONFIGURING;
+
+            return (res != STATUS_OK) ? res : xres;
         }
 
         status_t Schema::create_missing_styles(const StyleSheet *sheet)
@@ -369,63 +446,240 @@ namespace lsp
             return STATUS_OK;
         }
 
-        bool Schema::check_parents_configured(Style *s)
+        status_t Schema::configure_styles(const StyleSheet *sheet)
         {
-            for (size_t i=0, n=s->parents(); i<n; ++i)
+            status_t res;
+
+            // Styles of the sheet are already sorted in the order of inheritance
+            for (size_t i=0, n=sheet->vOrder.size(); i<n; ++i)
             {
-                Style *sp = s->parent(i);
-                if ((sp != NULL) && (!sp->configured()))
-                    return false;
+                StyleSheet::style_t *xs = sheet->vOrder.uget(i);
+                Style *s                = vStyles.get(&xs->name);
+                if ((s == NULL) || (s->configured()))
+                    continue;
+
+                //lsp_trace("Configuring style '%s'", xs->name.get_utf8());
+                if ((res = apply_settings(s, xs)) != STATUS_OK)
+                    return res;
+                s->set_configured(true);
             }
 
-            return true;
+            // Mark all other styles as configured
+            lltl::parray<Style> vs;
+            if (!vStyles.values(&vs))
+                return STATUS_NO_MEM;
+            for (size_t i=0, n=vs.size(); i<n; ++i)
+            {
+                Style *s                = vs.uget(i);
+                if (s != NULL)
+                    s->set_configured(true);
+            }
+
+            return STATUS_OK;
         }
 
-        status_t Schema::configure_styles(const StyleSheet *sheet)
+        status_t Schema::lock_style(Style *s)
+        {
+            if (s->locked())
+                return STATUS_OK;
+
+            status_t res = s->begin();
+            if (res != STATUS_OK)
+                return res;
+            if (!vLocked.add(s))
+            {
+                s->end();
+                return STATUS_NO_MEM;
+            }
+            s->set_locked(true);
+
+            return STATUS_OK;
+        }
+
+        status_t Schema::lock_styles()
         {
-            // List all possible styles sheet names
             status_t res;
-            lltl::parray<LSPString> vss;
-            if (!vStyles.keys(&vss))
+            lltl::parray<Style> vs;
+            if (!vStyles.values(&vs))
                 return STATUS_NO_MEM;
 
-            // Initialize all styles in the order of their inheritance
-            for (size_t i=0; vss.size() > 0; )
+            // Lock all styles of the schema
+            if ((pRoot != NULL) && ((res = lock_style(pRoot)) != STATUS_OK))
+                return res;
+            for (size_t i=0, n=vs.size(); i<n; ++i)
             {
-                i                      %= vss.size();
-                LSPString *name         = vss.uget(i);
-                Style *s                = vStyles.get(name);
+                Style *s = vs.uget(i);
+                if ((s != NULL) && ((res = lock_style(s)) != STATUS_OK))
+                    return res;
+            }
 
-                // Style does not exists or is already configured?
-                if ((s == NULL) || (s->configured()))
+            // Lock all descendant styles, including styles of widgets
+            for (size_t i=0; i<vLocked.size(); ++i)
+            {
+                Style *s = vLocked.uget(i);
+                for (size_t j=0, m=s->children(); j<m; ++j)
                 {
-                    vss.remove(i); // Remove the key
-                    continue;
+                    Style *c = s->child(j);
+                    if ((c != NULL) && ((res = lock_style(c)) != STATUS_OK))
+                        return res;
                 }
+            }
 
-                // Is there stylesheet present for this style?
-                StyleSheet::style_t *xs = sheet->vStyles.get(name);
-                if (xs == NULL)
-                {
-                    s->set_configured(true);
-                    vss.remove(i); // Remove the key
-                    continue;
-                }
+            return STATUS_OK;
+        }
 
-                // Check that parents of this style already have been configured
-                if (check_parents_configured(s))
+        status_t Schema::order_locked(lltl::parray<Style> *dst, Style *s)
+        {
+            // The flag is reset when the style is added to the list
+            if (!s->locked())
+                return STATUS_OK;
+            s->set_locked(false);
+
+            // Parents go first
+            status_t res;
+            for (size_t i=0, n=s->parents(); i<n; ++i)
+            {
+                Style *p = s->parent(i);
+                if ((p != NULL) && ((res = order_locked(dst, p)) != STATUS_OK))
+                    return res;
+            }
+
+            return (dst->add(s)) ? STATUS_OK : STATUS_NO_MEM;
+        }
+
+        status_t Schema::unlock_styles()
+        {
+            // Sort locked styles in the order of inheritance, so the pending changes
+            // of parents are delivered to children before children become unlocked
+            status_t res = STATUS_OK;
+            lltl::parray<Style> order;
+            for (size_t i=0, n=vLocked.size(); i<n; ++i)
+            {
+                if ((res = order_locked(&order, vLocked.uget(i))) != STATUS_OK)
+                    break;
+            }
+
+            // Fall back to the order of locking on error
+            if (res != STATUS_OK)
+            {
+                order.clear();
+                if (!order.add(vLocked))
+                    return STATUS_NO_MEM;
+            }
+
+            // Complete transactions, each style issues one coalesced burst of notifications
+            vLocked.clear();
+            for (size_t i=0, n=order.size(); i<n; ++i)
+            {
+                Style *s = order.uget(i);
+                s->set_locked(false);
+                s->end();
+            }
+
+            return res;
+        }
+
+        status_t Schema::link_styles(const CompiledStyleSheet *sheet, lltl::parray<Style> *styles)
+        {
+            status_t res;
+            lltl::parray<Style> vs;
+            if (!vStyles.values(&vs))
+                return STATUS_NO_MEM;
+
+            // Reset the 'configured' flag for all styles
+            for (size_t i=0, n=vs.size(); i<n; ++i)
+            {
+                Style *s                = vs.uget(i);
+                if (s != NULL)
+                    s->set_configured(false);
+            }
+
+            // Resolve styles of the style sheet, create missing and link them to parents
+            LSPString name;
+            size_t first            = (sheet->pHeader->flags & CompiledStyleSheet::F_ROOT) ? 1 : 0;
+            if ((first > 0) && (!styles->add(pRoot)))
+                return STATUS_NO_MEM;
+
+            for (size_t i=first, n=sheet->pHeader->styles.count; i<n; ++i)
+            {
+                if (!name.set_utf8(sheet->string(sheet->vStyles[i].name)))
+                    return STATUS_NO_MEM;
+
+                Style *s                = vStyles.get(&name);
+                if (s == NULL)
                 {
-                    //lsp_trace("Configuring style '%s'", name->get_utf8());
-                    if ((res = apply_settings(s, xs)) != STATUS_OK)
+                    if ((res = create_style(&name)) != STATUS_OK)
                         return res;
+                    if ((s = vStyles.get(&name)) == NULL)
+                        return STATUS_BAD_STATE;
+                }
+                if (!styles->add(s))
+                    return STATUS_NO_MEM;
 
-                    s->set_configured(true);
-                    vss.remove(i); // Remove the key
+                // The 'configured' flag marks styles linked by the style sheet
+                s->set_configured(true);
+            }
+
+            for (size_t i=0, n=styles->size(); i<n; ++i)
+            {
+                if ((res = apply_relations(styles->uget(i), sheet, i)) != STATUS_OK)
+                    return res;
+            }
+
+            // Link all other styles to default parents
+            for (size_t i=0, n=vs.size(); i<n; ++i)
+            {
+                Style *s                = vs.uget(i);
+                if ((s == NULL) || (s->configured()))
                     continue;
-                }
 
-                // Increment the position
-                ++i;
+                const char *default_parents = s->default_parents();
+                if (default_parents == NULL)
+                    default_parents = "root";
+                if ((res = apply_relations(s, default_parents)) != STATUS_OK)
+                    return res;
+            }
+
+            // Reset the 'configured' flag for linked styles
+            for (size_t i=0, n=styles->size(); i<n; ++i)
+                styles->uget(i)->set_configured(false);
+
+            return STATUS_OK;
+        }
+
+        status_t Schema::configure_styles(const CompiledStyleSheet *sheet, lltl::parray<Style> *styles)
+        {
+            status_t res;
+
+            // Cache of atoms, indexed by interned string
+            lltl::darray<atom_t> atoms;
+            size_t count            = sheet->pHeader->strings.count;
+            atom_t *va              = atoms.append_n(count);
+            if ((va == NULL) && (count > 0))
+                return STATUS_NO_MEM;
+            for (size_t i=0; i<count; ++i)
+                va[i]                   = -1;
+
+            // Styles are already stored in the order of inheritance
+            for (size_t i=0, n=styles->size(); i<n; ++i)
+            {
+                Style *s                = styles->uget(i);
+                if (s->configured())
+                    continue;
+                if ((res = apply_settings(s, sheet, i, &atoms)) != STATUS_OK)
+                    return res;
+                s->set_configured(true);
+            }
+
+            // Mark all other styles as configured
+            lltl::parray<Style> vs;
+            if (!vStyles.values(&vs))
+                return STATUS_NO_MEM;
+            for (size_t i=0, n=vs.size(); i<n; ++i)
+            {
+                Style *s                = vs.uget(i);
+                if (s != NULL)
+                    s->set_configured(true);
             }
 
             return STATUS_OK;
@@ -454,6 +708,7 @@ namespace lsp
             if (pDisplay != NULL)
             {
                 pDisplay->display()->remove_all_fonts();
+                pDisplay->text_cache()->clear();
                 load_fonts_from_sheet(sheet, loader);
             }
 
@@ -494,6 +749,35 @@ namespace lsp
             return STATUS_OK;
         }
 
+        status_t Schema::apply_internal(const CompiledStyleSheet *sheet, resource::ILoader *loader)
+        {
+            status_t res;
+
+            // Destroy all previously loaded and used fonts and apply new
+            if (pDisplay != NULL)
+            {
+                pDisplay->display()->remove_all_fonts();
+                pDisplay->text_cache()->clear();
+                load_fonts_from_sheet(sheet, loader);
+            }
+
+            // Destroy colors and copy colors from sheet
+            destroy_colors();
+            if ((res = init_colors_from_sheet(sheet)) != STATUS_OK)
+                return res;
+
+            // Destroy all relations between styles
+            if ((res = unlink_styles()) != STATUS_OK)
+                return res;
+
+            // Create missing styles, link and configure them
+            lltl::parray<Style> styles;
+            if ((res = link_styles(sheet, &styles)) != STATUS_OK)
+                return res;
+
+            return configure_styles(sheet, &styles);
+        }
+
         status_t Schema::apply_settings(Style *s, StyleSheet::style_t *xs)
         {
             lltl::parray<LSPString> pnames;
@@ -536,6 +820,87 @@ namespace lsp
             return STATUS_OK;
         }
 
+        status_t Schema::apply_settings(Style *s, const CompiledStyleSheet *sheet, size_t index, lltl::darray<atom_t> *atoms)
+        {
+            const CompiledStyleSheet::style_t *xs   = &sheet->vStyles[index];
+            const CompiledStyleSheet::prop_t *props = &sheet->vProps[xs->prop];
+            status_t res;
+
+            for (size_t i=0; i<xs->props; ++i)
+            {
+                const CompiledStyleSheet::prop_t *p = &props[i];
+
+                // Resolve atom of the property name
+                atom_t *id              = atoms->uget(p->name);
+                if (*id < 0)
+                {
+                    *id                     = pAtoms->atom_id(sheet->string(p->name));
+                    if (*id < 0)
+                        return STATUS_NO_MEM;
+                }
+
+                // Pick the pre-parsed value matching the type of the property
+                property_type_t type    = s->get_type(*id);
+                if (type == PT_UNKNOWN)
+                {
+                    if (p->flags & CompiledStyleSheet::P_TEXT_ONLY)
+                        continue;
+                    type                    = property_type_t(p->type);
+                }
+                else if ((type != PT_STRING) && (type != property_type_t(p->type)) &&
+                         ((type != PT_FLOAT) || (p->type != PT_INT)))
+                    continue;
+
+                bool over = s->set_override(true);
+                switch (type)
+                {
+                    case PT_BOOL:   res = s->set_bool(*id, p->bvalue != 0);                 break;
+                    case PT_INT:    res = s->set_int(*id, p->ivalue);                       break;
+                    case PT_FLOAT:
+                        res = s->set_float(*id, (p->type == PT_INT) ? float(p->ivalue) : p->fvalue);
+                        break;
+                    case PT_STRING: res = s->set_string(*id, sheet->string(p->text));       break;
+                    default:        res = STATUS_OK;
+                }
+                s->set_override(over);
+
+                if (res != STATUS_OK)
+                    return res;
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t Schema::apply_relations(Style *s, const CompiledStyleSheet *sheet, size_t index)
+        {
+            const CompiledStyleSheet::style_t *xs   = &sheet->vStyles[index];
+            const uint32_t *parents                 = &sheet->vParents[xs->parent];
+            status_t res;
+            LSPString parent;
+
+            for (size_t i=0; i<xs->parents; ++i)
+            {
+                const char *name = sheet->string(parents[i]);
+                Style *ps;
+                if (!::strcmp(name, "root"))
+                    ps = pRoot;
+                else
+                {
+                    if (!parent.set_utf8(name))
+                        return STATUS_NO_MEM;
+                    ps = vStyles.get(&parent);
+                }
+
+                if (ps != NULL)
+                {
+                    if ((res = s->add_parent(ps)) != STATUS_OK)
+                        return res;
+                }
+            }
+
+            return STATUS_OK;
+        }
+
         status_t Schema::apply_relations(Style *s, const lltl::parray<LSPString> *parents)
         {
             status_t res;
@@ -664,9 +1029,23 @@ namespace lsp
             if (style == NULL)
                 return STATUS_NO_MEM;
 
+            // Join the schema-wide transaction if it is active
+            if (!vLocked.is_empty())
+            {
+                status_t res    = lock_style(style);
+                if (res != STATUS_OK)
+                {
+                    delete style;
+                    return res;
+                }
+            }
+
             // Register style in the list
             if (!vStyles.create(name, style))
             {
+                // Leave the transaction before the style is deleted
+                if (style->locked())
+                    vLocked.premove(style);
                 delete style;
                 return STATUS_NO_MEM;
             }
@@ -833,6 +1212,114 @@ namespace lsp
             return pAtoms->atom_name(id);
         }
 
+        const atom_t *Schema::find_prop_atoms(atom_t id, const void *key)
+        {
+            if (size_t(id) >= vPropAtoms.size())
+                return NULL;
+
+            for (prop_atoms_t *pa = *(vPropAtoms.uget(id)); pa != NULL; pa = pa->pNext)
+            {
+                if (pa->pKey == key)
+                    return pa->vAtoms;
+            }
+
+            return NULL;
+        }
+
+        const atom_t *Schema::create_prop_atoms(atom_t id, const void *key, const lltl::parray<char> *postfix)
+        {
+            // Extend the cache if needed
+            if (size_t(id) >= vPropAtoms.size())
+            {
+                size_t count        = id + 1 - vPropAtoms.size();
+                prop_atoms_t **vpa  = vPropAtoms.append_n(count);
+                if (vpa == NULL)
+                    return NULL;
+                for (size_t i=0; i<count; ++i)
+                    vpa[i]              = NULL;
+            }
+
+            // Allocate new entry
+            size_t items        = postfix->size();
+            uint8_t *ptr        = static_cast<uint8_t *>(::malloc(sizeof(prop_atoms_t) + items * sizeof(atom_t)));
+            if (ptr == NULL)
+                return NULL;
+            prop_atoms_t *pa    = reinterpret_cast<prop_atoms_t *>(ptr);
+            pa->pKey            = key;
+            pa->vAtoms          = reinterpret_cast<atom_t *>(&ptr[sizeof(prop_atoms_t)]);
+
+            // Resolve atoms for all items
+            LSPString name;
+            if (!name.set_utf8(pAtoms->atom_name(id)))
+            {
+                ::free(ptr);
+                return NULL;
+            }
+            size_t len          = name.length();
+
+            for (size_t i=0; i<items; ++i)
+            {
+                name.set_length(len);
+                atom_t atom         = (name.append_ascii(postfix->uget(i))) ? pAtoms->atom_id(&name) : -STATUS_NO_MEM;
+                if (atom < 0)
+                {
+                    ::free(ptr);
+                    return NULL;
+                }
+                pa->vAtoms[i]       = atom;
+            }
+
+            // Link entry to the cache
+            prop_atoms_t **head = vPropAtoms.uget(id);
+            pa->pNext           = *head;
+            *head               = pa;
+
+            return pa->vAtoms;
+        }
+
+        const atom_t *Schema::property_atoms(atom_t id, const prop::desc_t *desc)
+        {
+            if ((id < 0) || (desc == NULL))
+                return NULL;
+
+            const atom_t *res = find_prop_atoms(id, desc);
+            if (res != NULL)
+                return res;
+
+            lltl::parray<char> postfix;
+            for (const prop::desc_t *d = desc; d->postfix != NULL; ++d)
+            {
+                if (!postfix.add(const_cast<char *>(d->postfix)))
+                    return NULL;
+            }
+
+            return create_prop_atoms(id, desc, &postfix);
+        }
+
+        const atom_t *Schema::property_atoms(atom_t id, const char * const *flags)
+        {
+            if ((id < 0) || (flags == NULL))
+                return NULL;
+
+            const atom_t *res = find_prop_atoms(id, flags);
+            if (res != NULL)
+                return res;
+
+            lltl::parray<char> postfix;
+            for (const char * const *f = flags; *f != NULL; ++f)
+            {
+                if (!postfix.add(const_cast<char *>(*f)))
+                    return NULL;
+            }
+
+            return create_prop_atoms(id, flags, &postfix);
+        }
+
+        const atom_t *Schema::property_atoms(const char *id, const prop::desc_t *desc)
+        {
+            return property_atoms(pAtoms->atom_id(id), desc);
+        }
+
         status_t Schema::get_language(LSPString *dst) const
         {
             // Check state
@@ -889,42 +1376,49 @@ namespace lsp
         status_t Schema::add_font(const char *name, const char *path)
         {
             ws::IDisplay *dpy = pDisplay->display();
+            pDisplay->text_cache()->clear();
             return (dpy != NULL) ? dpy->add_font(name, path) : STATUS_BAD_STATE;
         }
 
         status_t Schema::add_font(const char *name, const io::Path *path)
         {
             ws::IDisplay *dpy = pDisplay->display();
+            pDisplay->text_cache()->clear();
             return (dpy != NULL) ? dpy->add_font(name, path) : STATUS_BAD_STATE;
         }
 
         status_t Schema::add_font(const char *name, const LSPString *path)
         {
             ws::IDisplay *dpy = pDisplay->display();
+            pDisplay->text_cache()->clear();
             return (dpy != NULL) ? dpy->add_font(name, path) : STATUS_BAD_STATE;
         }
 
         status_t Schema::add_font(const char *name, io::IInStream *is)
         {
             ws::IDisplay *dpy = pDisplay->display();
+            pDisplay->text_cache()->clear();
             return (dpy != NULL) ? dpy->add_font(name, is) : STATUS_BAD_STATE;
         }
 
         status_t Schema::add_font_alias(const char *name, const char *alias)
         {
             ws::IDisplay *dpy = pDisplay->display();
+            pDisplay->text_cache()->clear();
             return (dpy != NULL) ? dpy->add_font_alias(name, alias) : STATUS_BAD_STATE;
         }
 
         status_t Schema::remove_font(const char *name)
         {
             ws::IDisplay *dpy = pDisplay->display();
+            pDisplay->text_cache()->clear();
             return (dpy != NULL) ? dpy->remove_font(name) : STATUS_BAD_STATE;
         }
 
         void Schema::remove_all_fonts()
         {
             ws::IDisplay *dpy = pDisplay->display();
+            pDisplay->text_cache()->clear();
             if (dpy != NULL)
                 dpy->remove_all_fonts();
         }
@@ -30,6 +30,8 @@ namespace lsp
         Style::Style(Schema *schema, const char *name, const char *parents)
         {
             pSchema     = schema;
+            vSlots      = NULL;
+            nSlots      = 0;
             nFlags      = 0;
             sName       = (name != NULL)    ? strdup(name)      : NULL;
             sDflParents = (parents != NULL) ? strdup(parents)   : NULL;
@@ -85,6 +87,14 @@ namespace lsp
                 undef_property(vProperties.uget(i));
             vProperties.flush();
 
+            // Destroy property index
+            if (vSlots != NULL)
+            {
+                ::free(vSlots);
+                vSlots      = NULL;
+            }
+            nSlots      = 0;
+
             // Destroy name
             if (sName != NULL)
             {
@@ -150,6 +160,13 @@ namespace lsp
             return res;
         }
 
+        bool Style::set_locked(bool set)
+        {
+            bool res = nFlags & S_LOCKED;
+            nFlags = lsp_setflag(nFlags, S_LOCKED, set);
+            return res;
+        }
+
         status_t Style::copy_property(property_t *dst, const property_t *src)
         {
             // Check type of property
@@ -238,7 +255,7 @@ namespace lsp
         Style::property_t *Style::create_property(atom_t id, const property_t *src, size_t flags)
         {
             // Allocate property
-            property_t *dst = vProperties.add();
+            property_t *dst = alloc_property(id);
             if (dst == NULL)
                 return NULL;
 
@@ -263,7 +280,7 @@ namespace lsp
                     // Update value
                     if ((dst->v.sValue = ::strdup(src->v.sValue)) == NULL)
                     {
-                        vProperties.premove(dst);
+                        free_property(dst);
                         return NULL;
                     }
 
@@ -273,21 +290,18 @@ namespace lsp
                     {
                         ::free(dst->v.sValue);
                         dst->v.sValue   = NULL;
-                        vProperties.premove(dst);
+                        free_property(dst);
                         return NULL;
                     }
                     break;
                 }
                 default:
+                    free_property(dst);
                     return NULL;
             }
 
-            dst->id         = id;
-            dst->refs       = 0;
             dst->type       = src->type;
-            dst->changes    = 0;
             dst->flags      = flags;
-            dst->owner      = this;
 
             return dst;
         }
@@ -295,7 +309,7 @@ namespace lsp
         Style::property_t *Style::create_property(atom_t id, property_type_t type, size_t flags)
         {
             // Allocate property
-            property_t *dst = vProperties.add();
+            property_t *dst = alloc_property(id);
             if (dst == NULL)
                 return NULL;
 
@@ -317,31 +331,213 @@ namespace lsp
                 case PT_STRING:
                     if ((dst->v.sValue = ::strdup("")) == NULL)
                     {
-                        vProperties.premove(dst);
+                        free_property(dst);
                         return NULL;
                     }
                     if ((dst->dv.sValue = ::strdup("")) == NULL)
                     {
                         ::free(dst->v.sValue);
                         dst->v.sValue   = NULL;
-                        vProperties.premove(dst);
+                        free_property(dst);
                         return NULL;
                     }
                     break;
                 default:
+                    free_property(dst);
                     return NULL;
             }
 
-            dst->id         = id;
-            dst->refs       = 0;
             dst->type       = type;
-            dst->changes    = 0;
             dst->flags      = flags;
-            dst->owner      = this;
 
             return dst;
         }
 
+        bool Style::rehash(size_t capacity)
+        {
+            slot_t *slots   = static_cast<slot_t *>(::malloc(capacity * sizeof(slot_t)));
+            if (slots == NULL)
+                return false;
+
+            for (size_t i=0; i<capacity; ++i)
+            {
+                slots[i].nId        = -1;
+                slots[i].nIndex     = -1;
+            }
+
+            // Index all existing properties
+            size_t mask     = capacity - 1;
+            for (size_t i=0, n=vProperties.size(); i<n; ++i)
+            {
+                property_t *p   = vProperties.uget(i);
+                size_t h        = atom_hash(p->id) & mask;
+                while (slots[h].nId >= 0)
+                    h               = (h + 1) & mask;
+
+                slots[h].nId    = p->id;
+                slots[h].nIndex = i;
+            }
+
+            // Replace the index
+            if (vSlots != NULL)
+                ::free(vSlots);
+            vSlots          = slots;
+            nSlots          = capacity;
+
+            return true;
+        }
+
+        Style::slot_t *Style::find_slot(atom_t id) const
+        {
+            if ((nSlots <= 0) || (id < 0))
+                return NULL;
+
+            // The index is never filled more than by half, so there always is an empty slot
+            size_t mask     = nSlots - 1;
+            for (size_t h = atom_hash(id) & mask; ; h = (h + 1) & mask)
+            {
+                slot_t *s       = &vSlots[h];
+                if (s->nId == id)
+                    return s;
+                else if (s->nId < 0)
+                    return NULL;
+            }
+        }
+
+        Style::property_t *Style::alloc_property(atom_t id)
+        {
+            // Keep the load factor of the index not greater than 1/2
+            if (((vProperties.size() + 1) << 1) > nSlots)
+            {
+                if (!rehash((nSlots > 0) ? nSlots << 1 : 16))
+                    return NULL;
+            }
+
+            // Allocate property
+            property_t *p   = vProperties.add();
+            if (p == NULL)
+                return NULL;
+
+            // Register property in the index
+            size_t mask     = nSlots - 1;
+            size_t h        = atom_hash(id) & mask;
+            while (vSlots[h].nId >= 0)
+                h               = (h + 1) & mask;
+            vSlots[h].nId   = id;
+            vSlots[h].nIndex= vProperties.size() - 1;
+
+            // Initialize common fields
+            p->id           = id;
+            p->type         = PT_UNKNOWN;
+            p->refs         = 0;
+            p->changes      = 0;
+            p->flags        = 0;
+            p->owner        = this;
+            p->first        = -1;
+            p->last         = -1;
+
+            return p;
+        }
+
+        void Style::free_property(property_t *p)
+        {
+            slot_t *s       = find_slot(p->id);
+            if (s == NULL)
+                return;
+            size_t index    = s->nIndex;
+
+            // Remove slot from the index with backward shift of the collision chain
+            size_t mask     = nSlots - 1;
+            size_t i        = s - vSlots;
+            for (size_t j = (i + 1) & mask; vSlots[j].nId >= 0; j = (j + 1) & mask)
+            {
+                // Move the slot if it's home position is cyclically outside of (i, j]
+                size_t k        = atom_hash(vSlots[j].nId) & mask;
+                if ((i <= j) ? ((k <= i) || (k > j)) : ((k <= i) && (k > j)))
+                {
+                    vSlots[i]       = vSlots[j];
+                    i               = j;
+                }
+            }
+            vSlots[i].nId   = -1;
+            vSlots[i].nIndex= -1;
+
+            // Remove property and update positions of all subsequent properties
+            vProperties.remove(index);
+            for (size_t n=vProperties.size(); index < n; ++index)
+            {
+                property_t *xp  = vProperties.uget(index);
+                find_slot(xp->id)->nIndex   = index;
+            }
+        }
+
+        ssize_t Style::find_listener(const property_t *p, IStyleListener *listener) const
+        {
+            const listener_t *pv = vListeners.array();
+            for (ssize_t i = p->first; i >= 0; i = pv[i].nNext)
+            {
+                if (pv[i].pListener == listener)
+                    return i;
+            }
+            return -1;
+        }
+
+        Style::listener_t *Style::alloc_listener(property_t *p, ssize_t *index)
+        {
+            listener_t *lst = vListeners.add();
+            if (lst == NULL)
+                return NULL;
+
+            // Link binding to the tail of property's chain
+            ssize_t idx     = vListeners.size() - 1;
+            lst->nId        = p->id;
+            lst->nPrev      = p->last;
+            lst->nNext      = -1;
+            if (p->last >= 0)
+                vListeners.uget(p->last)->nNext = idx;
+            else
+                p->first        = idx;
+            p->last         = idx;
+
+            if (index != NULL)
+                *index          = idx;
+
+            return lst;
+        }
+
+        void Style::free_listener(property_t *p, ssize_t index)
+        {
+            // Unlink binding from the property's chain
+            listener_t *lst = vListeners.uget(index);
+            if (lst->nPrev >= 0)
+                vListeners.uget(lst->nPrev)->nNext  = lst->nNext;
+            else
+                p->first        = lst->nNext;
+            if (lst->nNext >= 0)
+                vListeners.uget(lst->nNext)->nPrev  = lst->nPrev;
+            else
+                p->last         = lst->nPrev;
+
+            // Move the last binding to the released position to keep the list dense
+            ssize_t last    = vListeners.size() - 1;
+            if (index < last)
+            {
+                *lst            = *(vListeners.uget(last));
+                property_t *xp  = get_property(lst->nId);
+
+                if (lst->nPrev >= 0)
+                    vListeners.uget(lst->nPrev)->nNext  = index;
+                else if (xp != NULL)
+                    xp->first       = index;
+                if (lst->nNext >= 0)
+                    vListeners.uget(lst->nNext)->nPrev  = index;
+                else if (xp != NULL)
+                    xp->last        = index;
+            }
+
+            vListeners.remove(last);
+        }
+
         status_t Style::sync_property(property_t *p)
         {
 //            lsp_trace("name = %s, flags=0x%x", atom_name(p->id), p->flags);
@@ -596,23 +792,27 @@ namespace lsp
         {
             atom_t id = prop->id;
 
+            // Listeners are always bound to the local property
+            property_t *p = (prop->owner == this) ? prop : get_property(id);
+            if (p == NULL)
+                return;
+
             // Check whether we are in transactional state
             if ((vLocks.size() > 0) && (prop->owner == this))
             {
                 size_t count = 0;
 
                 // Mark all listeners for pending property change event except listeners in transaction
-                for (size_t i=0, n=vListeners.size(); i<n; ++i)
+                for (ssize_t i = p->first; i >= 0; )
                 {
                     listener_t *lst = vListeners.uget(i);
-                    if ((lst != NULL) && (lst->nId == id))
+                    i               = lst->nNext;
+
+                    // Check that listener is not excluded from notifications
+                    if (vLocks.index_of(lst->pListener) < 0)
                     {
-                        // Check that listener is not excluded from notifications
-                        if (vLocks.index_of(lst->pListener) < 0)
-                        {
-                            lst->bNotify    = true;
-                            ++count;
-                        }
+                        lst->bNotify    = true;
+                        ++count;
                     }
                 }
 
@@ -623,11 +823,11 @@ namespace lsp
             else
             {
                 // Notify all listeners about property change
-                for (size_t i=0, n=vListeners.size(); i<n; ++i)
+                for (ssize_t i = p->first; i >= 0; )
                 {
                     listener_t *lst = vListeners.uget(i);
-                    if ((lst != NULL) && (lst->nId == id))
-                        lst->pListener->notify(id);
+                    i               = lst->nNext;
+                    lst->pListener->notify(id);
                 }
             }
         }
@@ -641,10 +841,11 @@ namespace lsp
                 prop->flags &= ~F_NTF_LISTENERS;
 
                 // Notify all allowed listeners about property change
-                for (size_t i=0, n=vListeners.size(); i<n; ++i)
+                for (ssize_t i = prop->first; i >= 0; )
                 {
                     listener_t *lst = vListeners.uget(i);
-                    if ((lst != NULL) && (lst->nId == prop->id) && (lst->bNotify))
+                    i               = lst->nNext;
+                    if (lst->bNotify)
                     {
                         lst->bNotify    = false;
                         lst->pListener->notify(prop->id);
@@ -842,14 +1043,8 @@ namespace lsp
 
         bool Style::is_bound(atom_t id, IStyleListener *listener) const
         {
-            const listener_t *pv = vListeners.array();
-            for (size_t i=0, n=vListeners.size(); i<n; ++i)
-            {
-                const listener_t *p = &pv[i];
-                if ((p->nId == id) && (p->pListener == listener))
-                    return true;
-            }
-            return false;
+            const property_t *p = get_property(id);
+            return (p != NULL) ? find_listener(p, listener) >= 0 : false;
         }
 
         bool Style::is_bound(const char *id, IStyleListener *listener) const
@@ -885,28 +1080,27 @@ namespace lsp
                     return STATUS_NO_MEM;
 
                 // Allocate listener binding
-                lst = vListeners.add();
+                lst = alloc_listener(p, NULL);
                 if (lst == NULL)
                 {
                     undef_property(p);
-                    vProperties.premove(p);
+                    free_property(p);
                     return STATUS_NO_MEM;
                 }
             }
             else
             {
                 // Check that not already bound
-                if (is_bound(id, listener))
+                if (find_listener(p, listener) >= 0)
                     return STATUS_ALREADY_BOUND;
 
                 // Just allocate listener binding
-                lst = vListeners.add();
+                lst = alloc_listener(p, NULL);
                 if (lst == NULL)
                     return STATUS_NO_MEM;
             }
 
             // Save listener to allocated binding
-            lst->nId        = p->id;
             lst->bNotify    = vLocks.index_of(listener) < 0;
             lst->pListener  = listener;
             ++p->refs;
@@ -936,29 +1130,18 @@ namespace lsp
 
         status_t Style::unbind(atom_t id, IStyleListener *listener)
         {
-            // Find listener binding
-            listener_t *lst = NULL;
-            listener_t *pv = vListeners.array();
-            for (size_t i=0, n=vListeners.size(); i<n; ++i)
-            {
-                listener_t *p = &pv[i];
-                if ((p->nId == id) && (p->pListener == listener))
-                {
-                    lst = p;
-                    break;
-                }
-            }
-
-            if (lst == NULL)
-                return STATUS_NOT_BOUND;
-
             // Get property
             property_t *p = get_property(id);
             if (p == NULL)
-                return STATUS_CORRUPTED; // This actually should not ever happen
+                return STATUS_NOT_BOUND;
+
+            // Find listener binding
+            ssize_t index = find_listener(p, listener);
+            if (index < 0)
+                return STATUS_NOT_BOUND;
 
             // Remove listener binding and dereference property
-            vListeners.premove(lst);
+            free_listener(p, index);
             deref_property(p);
 
             return STATUS_OK;
@@ -988,18 +1171,13 @@ namespace lsp
             undef_property(p);
             property_t *parent = get_parent_property(p->id);
             notify_children((parent != NULL) ? parent : p);
-            vProperties.premove(p);
+            free_property(p);
         }
 
         Style::property_t *Style::get_property(atom_t id)
         {
-            for (size_t i=0, n=vProperties.size(); i<n; ++i)
-            {
-                property_t *p   = vProperties.uget(i);
-                if ((p != NULL) && (p->id == id))
-                    return p;
-            }
-            return NULL;
+            slot_t *s = find_slot(id);
+            return (s != NULL) ? vProperties.uget(s->nIndex) : NULL;
         }
 
         Style::property_t *Style::get_parent_property(atom_t id)
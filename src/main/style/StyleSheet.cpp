@@ -30,6 +30,7 @@ namespace lsp
     {
         StyleSheet::style_t::style_t()
         {
+            state       = S_NONE;
         }
 
         StyleSheet::style_t::~style_t()
@@ -84,6 +85,7 @@ namespace lsp
             vc.flush();
 
             // Delete styles
+            vOrder.flush();
             lltl::parray<style_t> vs;
             vStyles.values(&vs);
             vStyles.flush();
@@ -1277,8 +1279,15 @@ namespace lsp
             return get_font(&c, path, alias);
         }
 
+        ssize_t StyleSheet::cmp_styles(const style_t *a, const style_t *b)
+        {
+            return a->name.compare_to(&b->name);
+        }
+
         status_t StyleSheet::validate()
         {
+            vOrder.clear();
+
             if (pRoot != NULL)
             {
                 if (!pRoot->parents.is_empty())
@@ -1288,9 +1297,14 @@ namespace lsp
                 }
             }
 
+            // Visit styles in the order of names to get the stable result
             lltl::parray<style_t> vs;
             if (!vStyles.values(&vs))
                 return STATUS_NO_MEM;
+            vs.qsort(cmp_styles);
+
+            for (size_t i=0, n=vs.size(); i<n; ++i)
+                vs.uget(i)->state   = S_NONE;
 
             for (size_t i=0, n=vs.size(); i<n; ++i)
             {
@@ -1298,122 +1312,75 @@ namespace lsp
                 style_t *s = vs.uget(i);
                 status_t res = validate_style(s);
                 if (res != STATUS_OK)
+                {
+                    vOrder.clear();
                     return res;
+                }
             }
 
             return STATUS_OK;
         }
 
-        void StyleSheet::drop_paths(lltl::parray<path_t> *paths)
-        {
-            for (size_t i=0, n=paths->size(); i<n; ++i)
-            {
-                path_t *p = paths->uget(i);
-                if (p != NULL)
-                    delete p;
-            }
-            paths->flush();
-        }
-
         status_t StyleSheet::validate_style(style_t *s)
         {
-            lltl::parray<path_t> stack;
-            path_t *p = new path_t();
+            if (s->state == S_DONE)
+                return STATUS_OK;
+
+            // Perform depth-first search over parents, the path contains styles being visited
+            lltl::darray<path_t> path;
+            path_t *p = path.add();
             if (p == NULL)
                 return STATUS_NO_MEM;
-            else if (!stack.push(p))
-            {
-                delete p;
-                return STATUS_NO_MEM;
-            }
-            p->curr = s;
+            p->curr     = s;
+            p->index    = 0;
+            s->state    = S_PATH;
 
-            while (!stack.is_empty())
+            while ((p = path.last()) != NULL)
             {
-                // Get current path
-                p = stack.pop();
-                if (p == NULL)
-                {
-                    drop_paths(&stack);
-                    return STATUS_UNKNOWN_ERR;
-                }
-
-                // There is nothing to check?
                 s = p->curr;
-                if (s->parents.is_empty())
+
+                // All parents have been visited? Emit the style and step back
+                if (p->index >= s->parents.size())
                 {
-                    delete p;
+                    s->state    = S_DONE;
+                    if (!vOrder.add(s))
+                        return STATUS_NO_MEM;
+                    path.pop();
                     continue;
                 }
 
-                // Add current style to list of visited
-                if (!p->visited.add(s))
+                // Obtain the parent style
+                LSPString *name = s->parents.uget(p->index++);
+                if (name->equals_ascii("root"))
                 {
-                    delete p;
-                    drop_paths(&stack);
-                    return STATUS_NO_MEM;
-                }
-
-//                lsp_trace("Curr: %p (%s)", s, s->name.get_utf8());
-//                for (size_t i=0, n=p->visited.size(); i<n; ++i)
-//                {
-//                    style_t *xp = p->visited.uget(i);
-//                    lsp_trace("  visited: %p (%s)", xp, xp->name.get_utf8());
-//                }
-
-                for (size_t i=0, n=s->parents.size(); i<n; )
-                {
-                    // Obtain the parent style
-                    LSPString *name = s->parents.uget(i++);
-                    style_t *ps = name->equals_ascii("root") ? pRoot : vStyles.get(name);
-
-//                    lsp_trace("  testing: %p (%s), i=%d, n=%d", ps, (ps != NULL) ? ps->name.get_utf8() : "???", int(i), int(n));
-                    if (ps == NULL)
-                    {
-                        sError.fmt_utf8("Unexisting style found in tree: '%s'", (name != NULL) ? name->get_utf8() : "root");
-                        delete p;
-                        drop_paths(&stack);
-                        return STATUS_BAD_HIERARCHY;
-                    }
-                    else if (p->visited.contains(ps))
+                    if (pRoot == NULL)
                     {
-                        sError.fmt_utf8("Found inheritance loop at style '%s'", (name != NULL) ? name->get_utf8() : "root");
-                        delete p;
-                        drop_paths(&stack);
+                        sError.fmt_utf8("Unexisting style found in tree: '%s'", "root");
                         return STATUS_BAD_HIERARCHY;
                     }
+                    continue;
+                }
 
-                    // Check next step
-                    path_t *np = p;
-                    if (i < n)
-                    {
-                        np = new path_t();
-                        if (np == NULL)
-                        {
-                            drop_paths(&stack);
-                            delete p;
-                            return STATUS_NO_MEM;
-                        }
-
-                        if (!np->visited.add(p->visited)) // Copy list of visited
-                        {
-                            delete np;
-                            delete p;
-                            drop_paths(&stack);
-                            return STATUS_NO_MEM;
-                        }
-                    }
-
-                    np->curr    = ps;
-
-                    // Add path to stack
-                    if (!stack.push(np))
-                    {
-                        delete np;
-                        drop_paths(&stack);
-                        return STATUS_NO_MEM;
-                    }
+                style_t *ps = vStyles.get(name);
+                if (ps == NULL)
+                {
+                    sError.fmt_utf8("Unexisting style found in tree: '%s'", name->get_utf8());
+                    return STATUS_BAD_HIERARCHY;
+                }
+                else if (ps->state == S_PATH)
+                {
+                    sError.fmt_utf8("Found inheritance loop at style '%s'", name->get_utf8());
+                    return STATUS_BAD_HIERARCHY;
                 }
+                else if (ps->state == S_DONE)
+                    continue;
+
+                // Step to the parent
+                if ((p = path.add()) == NULL)
+                    return STATUS_NO_MEM;
+                p->curr     = ps;
+                p->index    = 0;
+                ps->state   = S_PATH;
             }
 
             return STATUS_OK;
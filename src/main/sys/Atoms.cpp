@@ -20,6 +20,9 @@
  */
 
 #include <lsp-plug.in/tk/tk.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#define ATOMS_CHUNK_SIZE        0x1000
 
 namespace lsp
 {
@@ -27,18 +30,115 @@ namespace lsp
     {
         Atoms::Atoms()
         {
+            vBuckets    = NULL;
+            nBuckets    = 0;
+            pHead       = NULL;
+            nLeft       = 0;
         }
         
         Atoms::~Atoms()
         {
-            // Destroy atoms
-            for (size_t i=0, n=vAtoms.size(); i<n; ++i)
+            // Destroy atom names
+            vAtoms.flush();
+            for (size_t i=0, n=vChunks.size(); i<n; ++i)
             {
-                char *ptr = vAtoms.uget(i);
+                char *ptr = vChunks.uget(i);
                 if (ptr != NULL)
                     ::free(ptr);
             }
-            vAtoms.flush();
+            vChunks.flush();
+            pHead       = NULL;
+            nLeft       = 0;
+
+            // Destroy hash index
+            if (vBuckets != NULL)
+            {
+                ::free(vBuckets);
+                vBuckets    = NULL;
+            }
+            nBuckets    = 0;
+        }
+
+        size_t Atoms::hash_name(const char *name, size_t *len)
+        {
+            // FNV-1a hash
+            size_t hash = 2166136261U;
+            const char *p = name;
+            for ( ; *p != '\0'; ++p)
+                hash    = (hash ^ uint8_t(*p)) * 16777619U;
+
+            *len        = p - name;
+            return hash;
+        }
+
+        char *Atoms::intern(const char *name, size_t len)
+        {
+            size_t size = len + 1;
+
+            // Allocate new chunk if there is not enough space
+            if (size > nLeft)
+            {
+                size_t csize    = (size > ATOMS_CHUNK_SIZE) ? size : ATOMS_CHUNK_SIZE;
+                char *chunk     = static_cast<char *>(::malloc(csize));
+                if (chunk == NULL)
+                    return NULL;
+                if (!vChunks.add(chunk))
+                {
+                    ::free(chunk);
+                    return NULL;
+                }
+
+                // Oversized names get their own chunk, keep the current one
+                if (csize > ATOMS_CHUNK_SIZE)
+                {
+                    ::memcpy(chunk, name, size);
+                    return chunk;
+                }
+
+                pHead           = chunk;
+                nLeft           = csize;
+            }
+
+            char *res   = pHead;
+            ::memcpy(res, name, size);
+            pHead      += size;
+            nLeft      -= size;
+
+            return res;
+        }
+
+        bool Atoms::rehash(size_t capacity)
+        {
+            bucket_t *buckets = static_cast<bucket_t *>(::malloc(capacity * sizeof(bucket_t)));
+            if (buckets == NULL)
+                return false;
+
+            for (size_t i=0; i<capacity; ++i)
+            {
+                buckets[i].nHash    = 0;
+                buckets[i].nId      = -1;
+            }
+
+            // Move all existing entries to the new index
+            size_t mask = capacity - 1;
+            for (size_t i=0; i<nBuckets; ++i)
+            {
+                const bucket_t *b = &vBuckets[i];
+                if (b->nId < 0)
+                    continue;
+
+                size_t h        = b->nHash & mask;
+                while (buckets[h].nId >= 0)
+                    h               = (h + 1) & mask;
+                buckets[h]      = *b;
+            }
+
+            if (vBuckets != NULL)
+                ::free(vBuckets);
+            vBuckets    = buckets;
+            nBuckets    = capacity;
+
+            return true;
         }
 
         atom_t Atoms::atom_id(const char *name)
@@ -47,25 +147,43 @@ namespace lsp
                 return -STATUS_BAD_ARGUMENTS;
 
             // Find existing atom
+            size_t len;
+            size_t hash = hash_name(name, &len);
+            size_t mask = nBuckets - 1;
+            size_t h    = hash & mask;
+
+            if (nBuckets > 0)
+            {
+                for ( ; vBuckets[h].nId >= 0; h = (h + 1) & mask)
+                {
+                    const bucket_t *b = &vBuckets[h];
+                    if ((b->nHash == hash) && (!::strcmp(vAtoms.uget(b->nId), name)))
+                        return b->nId;
+                }
+            }
+
+            // Keep the load factor of the index not greater than 1/2
             size_t last = vAtoms.size();
-            for (size_t i=0; i<last; ++i)
+            if (((last + 1) << 1) > nBuckets)
             {
-                const char *aname = vAtoms.uget(i);
-                if (!::strcmp(aname, name))
-                    return i;
+                if (!rehash((nBuckets > 0) ? nBuckets << 1 : 256))
+                    return -STATUS_NO_MEM;
+
+                mask        = nBuckets - 1;
+                for (h = hash & mask; vBuckets[h].nId >= 0; h = (h + 1) & mask)
+                    /* nothing */ ;
             }
 
             // Allocate new atom name
-            char *aname         = ::strdup(name);
+            char *aname         = intern(name, len);
             if (aname == NULL)
                 return -STATUS_NO_MEM;
-
-            // Insert atom name to the found position
             if (!vAtoms.add(aname))
-            {
-                ::free(aname);
                 return -STATUS_NO_MEM;
-            }
+
+            // Register atom in the index
+            vBuckets[h].nHash   = hash;
+            vBuckets[h].nId     = last;
 
             return last;
         }
@@ -21,9 +21,15 @@
 
 #include <lsp-plug.in/tk/tk.h>
 #include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/debug.h>
 #include <lsp-plug.in/ws/factory.h>
 #include <lsp-plug.in/i18n/Dictionary.h>
 #include <private/tk/style/BuiltinStyle.h>
+#include <time.h>
+
+#define UPDATE_QUEUE_SIZE       0x40000
+#define WIDGET_INDEX_BINS       0x40
+#define SCHEMA_READ_CHUNK       0x400
 
 namespace lsp
 {
@@ -36,6 +42,12 @@ namespace lsp
             pDisplay        = NULL;
             pResourceLoader = NULL;
             pEnv            = NULL;
+            nRedrawTask     = -1;
+            nRedrawTime     = 0;
+            vIdBins         = NULL;
+            vWBins          = NULL;
+            nBins           = 0;
+            nBuildLocks     = 0;
 
             // Apply custom settings
             if (settings != NULL)
@@ -58,6 +70,30 @@ namespace lsp
 
         void Display::do_destroy()
         {
+            // Drop deferred build requests
+            for (size_t i=0, n=vBuild.size(); i<n; ++i)
+            {
+                Widget *w = vBuild.uget(i);
+                if (w != NULL)
+                    w->pBuildList   = NULL;
+            }
+            vBuild.flush();
+            nBuildLocks = 0;
+
+            // Destroy hash index, widgets are not looked up anymore
+            vUnindexed.flush();
+            if (vIdBins != NULL)
+            {
+                ::free(vIdBins);
+                vIdBins     = NULL;
+            }
+            if (vWBins != NULL)
+            {
+                ::free(vWBins);
+                vWBins      = NULL;
+            }
+            nBins       = 0;
+
             // Auto-destruct widgets
             size_t n    = sWidgets.size();
             for (size_t i=0; i<n; ++i)
@@ -77,10 +113,21 @@ namespace lsp
             }
             sWidgets.flush();
 
+            // Destroy cached surfaces and text metrics
+            sSurfaces.destroy();
+            sTextCache.clear();
+            sUpdates.destroy();
+
             // Execute slot
             sSlots.execute(SLOT_DESTROY, NULL);
             sSlots.destroy();
 
+            // Cancel redraw
+            vRedraw.flush();
+            if ((nRedrawTask >= 0) && (pDisplay != NULL))
+                pDisplay->cancel_task(nRedrawTask);
+            nRedrawTask     = -1;
+
             // Destroy display
             if (pDisplay != NULL)
             {
@@ -109,11 +156,94 @@ namespace lsp
             if (_this == NULL)
                 return STATUS_BAD_ARGUMENTS;
 
+            _this->sUpdates.drain();
             _this->garbage_collect();
 
             return STATUS_OK;
         }
 
+        status_t Display::redraw_task_handler(ws::timestamp_t sched, ws::timestamp_t time, void *arg)
+        {
+            Display *_this   = static_cast<Display *>(arg);
+            if (_this == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            _this->nRedrawTask  = -1;
+            _this->render_windows(time);
+
+            return STATUS_OK;
+        }
+
+        ws::timestamp_t Display::current_time()
+        {
+            struct timespec ts;
+            clock_gettime(CLOCK_REALTIME, &ts);
+            return (ts.tv_sec * 1000L) + (ts.tv_nsec / 1000000L);
+        }
+
+        void Display::render_windows(ws::timestamp_t time)
+        {
+            // Render all windows which frame time has come. Windows that query for redraw
+            // while rendering are appended to the list and already have the next frame time
+            for (size_t i=0; i<vRedraw.size(); )
+            {
+                Window *wnd = vRedraw.uget(i);
+                if (wnd->nNextFrame > time)
+                {
+                    ++i;
+                    continue;
+                }
+
+                vRedraw.qremove(i);
+                wnd->render_frame(time);
+            }
+
+            // Schedule next redraw if there are pending requests
+            schedule_redraw();
+        }
+
+        void Display::schedule_redraw()
+        {
+            if ((pDisplay == NULL) || (vRedraw.is_empty()))
+                return;
+
+            // Find the nearest frame time
+            ws::timestamp_t time = vRedraw.uget(0)->nNextFrame;
+            for (size_t i=1, n=vRedraw.size(); i<n; ++i)
+                time    = lsp_min(time, vRedraw.uget(i)->nNextFrame);
+
+            // Re-submit the task only if it should be launched earlier
+            if (nRedrawTask >= 0)
+            {
+                if (nRedrawTime <= time)
+                    return;
+                pDisplay->cancel_task(nRedrawTask);
+                nRedrawTask     = -1;
+            }
+
+            ws::taskid_t id = pDisplay->submit_task(time, redraw_task_handler, this);
+            if (id < 0)
+                return;
+
+            nRedrawTask     = id;
+            nRedrawTime     = time;
+        }
+
+        void Display::query_redraw(Window *wnd)
+        {
+            if (vRedraw.index_of(wnd) >= 0)
+                return;
+            if (!vRedraw.add(wnd))
+                return;
+
+            schedule_redraw();
+        }
+
+        void Display::cancel_redraw(Window *wnd)
+        {
+            vRedraw.premove(wnd);
+        }
+
         void Display::garbage_collect()
         {
             for (size_t i=0, n=vGarbage.size(); i<n; ++i)
@@ -123,20 +253,14 @@ namespace lsp
                 if (w == NULL)
                     continue;
 
-                // Widget is registered?
-                for (size_t j=0, m=sWidgets.size(); j<m; )
+                // Widget is registered? Free all bindings
+                item_t *item;
+                while ((item = find_item(w)) != NULL)
                 {
-                    item_t *item = sWidgets.uget(j);
-                    if (item->widget == w)
-                    {
-                        // Free the binding
-                        sWidgets.qremove(j);
-                        item->id        = NULL;
-                        item->widget    = NULL;
-                        ::free(item);
-                    }
-                    else
-                        ++j;
+                    unlink_item(item);
+                    item->id        = NULL;
+                    item->widget    = NULL;
+                    ::free(item);
                 }
 
                 // Destroy widget
@@ -193,6 +317,10 @@ namespace lsp
             if (res != STATUS_OK)
                 return res;
 
+            // Initialize queue of property updates
+            if ((res = sUpdates.init(UPDATE_QUEUE_SIZE)) != STATUS_OK)
+                return res;
+
             // Create slots
             Slot *slot   = sSlots.add(SLOT_DESTROY);
             if (slot == NULL)
@@ -244,19 +372,64 @@ namespace lsp
             if (schema_path == NULL)
                 return STATUS_OK;
 
-            // Load style sheet
-            StyleSheet sheet;
+            // Read style sheet
+            LSPString text;
             io::IInSequence *is = pResourceLoader->read_sequence(schema_path);
             if (is == NULL)
                 return STATUS_NOT_FOUND;
-
-            // Parse style
-            res = sheet.parse_data(is, WRAP_CLOSE | WRAP_DELETE);
+            res = read_schema_text(&text, is);
+            is->close();
+            delete is;
             if (res != STATUS_OK)
                 return res;
 
-            // Apply loaded schema
-            return sSchema.apply(&sheet);
+            // Apply the compiled schema if it is up to date
+            CompiledStyleSheet compiled;
+            uint64_t checksum       = CompiledStyleSheet::checksum(&text);
+            const char *cache_path  = pEnv->get_utf8(LSP_TK_ENV_SCHEMA_CACHE);
+            if ((cache_path != NULL) &&
+                (compiled.load(cache_path) == STATUS_OK) &&
+                (compiled.source_checksum() == checksum))
+            {
+                if ((res = sSchema.apply(&compiled)) == STATUS_OK)
+                    return res;
+                lsp_warn("Could not apply compiled schema \"%s\", error code %d", cache_path, int(res));
+            }
+
+            // The compiled schema is missing or stale, parse the style sheet and apply it
+            StyleSheet sheet;
+            if ((res = sheet.parse_data(&text)) != STATUS_OK)
+                return res;
+            if ((res = sSchema.apply(&sheet)) != STATUS_OK)
+                return res;
+
+            // Update the compiled schema
+            if (cache_path != NULL)
+            {
+                res = compiled.compile(&sheet, checksum);
+                if (res == STATUS_OK)
+                    res = compiled.save(cache_path);
+                if (res != STATUS_OK)
+                    lsp_warn("Could not save compiled schema \"%s\", error code %d", cache_path, int(res));
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t Display::read_schema_text(LSPString *dst, io::IInSequence *is)
+        {
+            lsp_wchar_t buf[SCHEMA_READ_CHUNK];
+
+            while (true)
+            {
+                ssize_t n = is->read(buf, SCHEMA_READ_CHUNK);
+                if (n < 0)
+                    return (n == -STATUS_EOF) ? STATUS_OK : status_t(-n);
+                else if (n == 0)
+                    return STATUS_OK;
+                if (!dst->append(buf, n))
+                    return STATUS_NO_MEM;
+            }
         }
 
         status_t Display::main()
@@ -312,17 +485,24 @@ namespace lsp
 
         Widget **Display::add(const char *id)
         {
+            size_t hash = 0, len = 0;
+
             // Prevent from duplicates
             if (id != NULL)
             {
                 // Check that widget does not exist
-                Widget *widget = get(id);
-                if (widget != NULL)
+                hash            = hash_name(id, &len);
+                item_t *item    = find_item(id, hash);
+                if ((item != NULL) && (item->widget != NULL))
                     return NULL;
             }
 
+            // Grow the hash index if necessary
+            if ((sWidgets.size() >= nBins) && (!grow_index()))
+                return NULL;
+
             // Allocate memory
-            size_t slen     = (id != NULL) ? (::strlen(id) + 1) * sizeof(char) : 0;
+            size_t slen     = (id != NULL) ? (len + 1) * sizeof(char) : 0;
             size_t to_alloc = align_size(sizeof(item_t) + slen, DEFAULT_ALIGN);
 
             // Append widget
@@ -334,85 +514,221 @@ namespace lsp
                 ::free(w);
                 return NULL;
             }
+            else if (!vUnindexed.add(w))
+            {
+                sWidgets.qremove(sWidgets.size() - 1);
+                ::free(w);
+                return NULL;
+            }
 
             // Initialize widget
             w->widget       = NULL;
             w->id           = NULL;
+            w->nHash        = hash;
+            w->nIndex       = sWidgets.size() - 1;
+            w->pIndexed     = NULL;
+            w->pIdNext      = NULL;
+            w->pWNext       = NULL;
             if (id != NULL)
             {
                 w->id           = reinterpret_cast<char *>(&w[1]);
                 ::memcpy(w->id, id, slen);
+
+                // Link to the identifier index
+                item_t **bin    = &vIdBins[hash & (nBins - 1)];
+                w->pIdNext      = *bin;
+                *bin            = w;
             }
 
+            // The widget pointer is assigned by the caller after the call,
+            // so the item is indexed by the widget pointer later
             return &w->widget;
         }
 
-        Widget *Display::get(const char *id)
+        size_t Display::hash_widget(const Widget *widget)
         {
-            if (id == NULL)
-                return NULL;
+            size_t hash = reinterpret_cast<size_t>(widget);
+            hash       ^= hash >> 16;
+            hash       *= 0x45d9f3b;
+            hash       ^= hash >> 16;
+            return hash;
+        }
+
+        bool Display::grow_index()
+        {
+            size_t bins     = (nBins > 0) ? nBins << 1 : WIDGET_INDEX_BINS;
+            item_t **vid    = static_cast<item_t **>(::calloc(bins, sizeof(item_t *)));
+            if (vid == NULL)
+                return false;
+            item_t **vw     = static_cast<item_t **>(::calloc(bins, sizeof(item_t *)));
+            if (vw == NULL)
+            {
+                ::free(vid);
+                return false;
+            }
 
+            // Re-link all items to the new bins
+            size_t mask     = bins - 1;
             for (size_t i=0, n=sWidgets.size(); i<n; ++i)
             {
-                item_t *ptr     = sWidgets.uget(i);
-                if (ptr->id == NULL)
+                item_t *item    = sWidgets.uget(i);
+                if (item->id != NULL)
+                {
+                    item_t **bin    = &vid[item->nHash & mask];
+                    item->pIdNext   = *bin;
+                    *bin            = item;
+                }
+                if (item->pIndexed != NULL)
+                {
+                    item_t **bin    = &vw[hash_widget(item->pIndexed) & mask];
+                    item->pWNext    = *bin;
+                    *bin            = item;
+                }
+            }
+
+            if (vIdBins != NULL)
+                ::free(vIdBins);
+            if (vWBins != NULL)
+                ::free(vWBins);
+
+            vIdBins         = vid;
+            vWBins          = vw;
+            nBins           = bins;
+
+            return true;
+        }
+
+        void Display::index_widgets()
+        {
+            for (size_t i=0; i<vUnindexed.size(); )
+            {
+                item_t *item    = vUnindexed.uget(i);
+                if (item->widget == NULL)
+                {
+                    ++i;
                     continue;
-                if (!strcmp(ptr->id, id))
-                    return ptr->widget;
+                }
+
+                item_t **bin    = &vWBins[hash_widget(item->widget) & (nBins - 1)];
+                item->pIndexed  = item->widget;
+                item->pWNext    = *bin;
+                *bin            = item;
+                vUnindexed.qremove(i);
+            }
+        }
+
+        Display::item_t *Display::find_item(const char *id, size_t hash)
+        {
+            if (nBins <= 0)
+                return NULL;
+
+            for (item_t *item = vIdBins[hash & (nBins - 1)]; item != NULL; item = item->pIdNext)
+            {
+                if ((item->nHash == hash) && (!strcmp(item->id, id)))
+                    return item;
             }
 
             return NULL;
         }
 
-        Widget *Display::remove(const char *id)
+        Display::item_t *Display::find_item(const Widget *widget)
         {
-            if (id == NULL)
+            if ((nBins <= 0) || (widget == NULL))
                 return NULL;
 
-            size_t n    = sWidgets.size();
-            for (size_t i=0; i<n; ++i)
+            index_widgets();
+            for (item_t *item = vWBins[hash_widget(widget) & (nBins - 1)]; item != NULL; item = item->pWNext)
             {
-                item_t *ptr     = sWidgets.uget(i);
-                if (ptr->id == NULL)
-                    continue;
-                if (!strcmp(ptr->id, id))
-                {
-                    Widget *result = ptr->widget;
-                    sWidgets.remove(i);
-                    return result;
-                }
+                if (item->pIndexed == widget)
+                    return item;
             }
 
             return NULL;
         }
 
-        bool Display::remove(Widget *widget)
+        void Display::unlink_item(item_t *item)
         {
-            size_t n    = sWidgets.size();
-            for (size_t i=0; i<n; ++i)
+            // Unlink from the identifier index
+            if (item->id != NULL)
             {
-                item_t *ptr     = sWidgets.uget(i);
-                if (ptr->widget == widget)
+                for (item_t **p = &vIdBins[item->nHash & (nBins - 1)]; *p != NULL; p = &(*p)->pIdNext)
                 {
-                    sWidgets.remove(i);
-                    return true;
+                    if (*p == item)
+                    {
+                        *p      = item->pIdNext;
+                        break;
+                    }
                 }
             }
 
-            return false;
+            // Unlink from the widget index
+            if (item->pIndexed != NULL)
+            {
+                for (item_t **p = &vWBins[hash_widget(item->pIndexed) & (nBins - 1)]; *p != NULL; p = &(*p)->pWNext)
+                {
+                    if (*p == item)
+                    {
+                        *p      = item->pWNext;
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                ssize_t index   = vUnindexed.index_of(item);
+                if (index >= 0)
+                    vUnindexed.qremove(index);
+            }
+
+            // Remove from the list, the last item takes the place of removed one
+            item_t *last    = sWidgets.last();
+            sWidgets.qremove(item->nIndex);
+            if (last != item)
+                last->nIndex    = item->nIndex;
         }
 
-        bool Display::exists(Widget *widget)
+        Widget *Display::get(const char *id)
         {
-            size_t n    = sWidgets.size();
-            for (size_t i=0; i<n; ++i)
-            {
-                item_t *ptr     = sWidgets.uget(i);
-                if (ptr->widget == widget)
-                    return true;
-            }
+            if (id == NULL)
+                return NULL;
 
-            return false;
+            size_t len;
+            item_t *item    = find_item(id, hash_name(id, &len));
+            return (item != NULL) ? item->widget : NULL;
+        }
+
+        Widget *Display::remove(const char *id)
+        {
+            if (id == NULL)
+                return NULL;
+
+            size_t len;
+            item_t *item    = find_item(id, hash_name(id, &len));
+            if (item == NULL)
+                return NULL;
+
+            Widget *result  = item->widget;
+            unlink_item(item);
+            ::free(item);
+
+            return result;
+        }
+
+        bool Display::remove(Widget *widget)
+        {
+            item_t *item    = find_item(widget);
+            if (item == NULL)
+                return false;
+
+            unlink_item(item);
+            ::free(item);
+
+            return true;
+        }
+
+        bool Display::exists(Widget *widget)
+        {
+            return find_item(widget) != NULL;
         }
 
         status_t Display::get_clipboard(size_t id, ws::IDataSink *sink)
@@ -444,6 +760,82 @@ namespace lsp
         {
             return vGarbage.add(widget) ? STATUS_OK : STATUS_NO_MEM;
         }
+
+        status_t Display::begin_build()
+        {
+            ++nBuildLocks;
+            return STATUS_OK;
+        }
+
+        status_t Display::end_build()
+        {
+            if (nBuildLocks <= 0)
+                return STATUS_BAD_STATE;
+            if (nBuildLocks > 1)
+            {
+                --nBuildLocks;
+                return STATUS_OK;
+            }
+
+            // Deliver pending style notifications first, the requests issued
+            // by them are still deferred. The list may grow while iterating
+            for (size_t i=0; i<vBuild.size(); ++i)
+            {
+                Widget *w = vBuild.uget(i);
+                if (w != NULL)
+                    w->commit_build_style();
+            }
+
+            // Leave the build mode and replay deferred requests from the private list:
+            // event handlers may start another build which collects its own requests.
+            // Widgets destroyed by event handlers during the replay clear their entries
+            // in the list being replayed
+            lltl::parray<Widget> items;
+            items.swap(vBuild);
+            nBuildLocks     = 0;
+
+            for (size_t i=0, n=items.size(); i<n; ++i)
+            {
+                Widget *w = items.uget(i);
+                if (w != NULL)
+                    w->pBuildList   = &items;
+            }
+
+            for (size_t i=0; i<items.size(); ++i)
+            {
+                Widget *w = items.uget(i);
+                if (w == NULL)
+                    continue;
+
+                w->pBuildList   = NULL;
+                w->commit_build();
+            }
+            items.flush();
+
+            return STATUS_OK;
+        }
+
+        bool Display::add_build(Widget *widget)
+        {
+            size_t index = vBuild.size();
+            if (!vBuild.add(widget))
+                return false;
+
+            widget->pBuildList  = &vBuild;
+            widget->nBuildIndex = index;
+            return true;
+        }
+
+        void Display::cancel_build(Widget *widget)
+        {
+            // The widget stores the list and the position it has been placed at
+            lltl::parray<Widget> *list = widget->pBuildList;
+            if (list == NULL)
+                return;
+
+            list->array()[widget->nBuildIndex] = NULL;
+            widget->pBuildList  = NULL;
+        }
     }
 
 } /* namespace lsp */
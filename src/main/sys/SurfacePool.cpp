@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-tk-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-tk-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-tk-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-tk-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <lsp-plug.in/tk/tk.h>
+#include <lsp-plug.in/common/alloc.h>
+#include <stdlib.h>
+
+#define SURFACE_POOL_BINS       0x100
+#define SURFACE_POOL_BUDGET     0x2000000
+
+namespace lsp
+{
+    namespace tk
+    {
+        SurfacePool::SurfacePool()
+        {
+            vBins           = NULL;
+            pHead           = NULL;
+            pTail           = NULL;
+            nBudget         = SURFACE_POOL_BUDGET;
+            nBytes          = 0;
+            nItems          = 0;
+            nHits           = 0;
+            nMisses         = 0;
+            bActive         = true;
+        }
+
+        SurfacePool::~SurfacePool()
+        {
+            destroy();
+        }
+
+        void SurfacePool::destroy()
+        {
+            clear();
+            bActive         = false;
+
+            if (vBins != NULL)
+            {
+                ::free(vBins);
+                vBins           = NULL;
+            }
+        }
+
+        inline size_t SurfacePool::bin_index(size_t width, size_t height)
+        {
+            return ((width * 0x9e3779b1) ^ (height * 0x85ebca6b)) & (SURFACE_POOL_BINS - 1);
+        }
+
+        inline size_t SurfacePool::estimate(size_t width, size_t height)
+        {
+            return width * height * sizeof(uint32_t);
+        }
+
+        void SurfacePool::destroy_surface(ws::ISurface *s)
+        {
+            s->destroy();
+            delete s;
+        }
+
+        void SurfacePool::unlink(item_t *item)
+        {
+            // Remove from the hash bin
+            for (item_t **pi = &vBins[item->nBin]; *pi != NULL; pi = &(*pi)->pBinNext)
+            {
+                if (*pi == item)
+                {
+                    *pi             = item->pBinNext;
+                    break;
+                }
+            }
+
+            // Remove from the LRU list
+            if (item->pPrev != NULL)
+                item->pPrev->pNext  = item->pNext;
+            else
+                pHead               = item->pNext;
+            if (item->pNext != NULL)
+                item->pNext->pPrev  = item->pPrev;
+            else
+                pTail               = item->pPrev;
+
+            nBytes         -= item->nBytes;
+            --nItems;
+        }
+
+        void SurfacePool::shrink(size_t bytes)
+        {
+            while ((pTail != NULL) && (nBytes > bytes))
+            {
+                item_t *item    = pTail;
+                unlink(item);
+                destroy_surface(item->pSurface);
+                ::free(item);
+            }
+        }
+
+        void SurfacePool::clear()
+        {
+            shrink(0);
+        }
+
+        void SurfacePool::set_budget(size_t bytes)
+        {
+            nBudget         = bytes;
+            shrink(nBudget);
+        }
+
+        ws::ISurface *SurfacePool::acquire(ws::ISurface *s, size_t width, size_t height)
+        {
+            if ((width <= 0) || (height <= 0))
+                return NULL;
+
+            // Lookup for the most recently released surface of the same size
+            if (vBins != NULL)
+            {
+                for (item_t *item = vBins[bin_index(width, height)]; item != NULL; item = item->pBinNext)
+                {
+                    ws::ISurface *res = item->pSurface;
+                    if ((res->width() != width) || (res->height() != height))
+                        continue;
+
+                    unlink(item);
+                    ::free(item);
+                    ++nHits;
+
+                    // Make the reused surface look like the newly created one
+                    res->begin();
+                        res->clear(lsp::Color(0.0f, 0.0f, 0.0f, 1.0f));
+                    res->end();
+
+                    return res;
+                }
+            }
+
+            // Allocate new surface
+            ++nMisses;
+            return (s != NULL) ? s->create(width, height) : NULL;
+        }
+
+        void SurfacePool::release(ws::ISurface *s)
+        {
+            if (s == NULL)
+                return;
+
+            // Check that the surface can be kept
+            size_t bytes    = estimate(s->width(), s->height());
+            if ((!bActive) || (bytes > nBudget))
+            {
+                destroy_surface(s);
+                return;
+            }
+
+            // Allocate bins and the new item
+            if (vBins == NULL)
+            {
+                vBins           = static_cast<item_t **>(::calloc(SURFACE_POOL_BINS, sizeof(item_t *)));
+                if (vBins == NULL)
+                {
+                    destroy_surface(s);
+                    return;
+                }
+            }
+
+            item_t *item    = static_cast<item_t *>(::malloc(sizeof(item_t)));
+            if (item == NULL)
+            {
+                destroy_surface(s);
+                return;
+            }
+
+            // Free space for the new surface
+            shrink(nBudget - bytes);
+
+            // Link the item
+            item->pSurface  = s;
+            item->nBytes    = bytes;
+            item->nBin      = bin_index(s->width(), s->height());
+            item->pPrev     = NULL;
+            item->pNext     = pHead;
+            item->pBinNext  = vBins[item->nBin];
+
+            if (pHead != NULL)
+                pHead->pPrev    = item;
+            else
+                pTail           = item;
+            pHead           = item;
+            vBins[item->nBin]   = item;
+
+            nBytes         += bytes;
+            ++nItems;
+        }
+    }
+}
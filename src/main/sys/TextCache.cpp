@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-tk-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-tk-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-tk-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-tk-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <lsp-plug.in/tk/tk.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEXT_CACHE_BINS         0x400
+#define TEXT_CACHE_CAPACITY     0x400
+
+namespace lsp
+{
+    namespace tk
+    {
+        TextCache::TextCache()
+        {
+            vBins           = NULL;
+            pHead           = NULL;
+            pTail           = NULL;
+            nCapacity       = TEXT_CACHE_CAPACITY;
+            nItems          = 0;
+            nHits           = 0;
+            nMisses         = 0;
+        }
+
+        TextCache::~TextCache()
+        {
+            clear();
+
+            if (vBins != NULL)
+            {
+                ::free(vBins);
+                vBins           = NULL;
+            }
+        }
+
+        void TextCache::make_key(key_t *key, size_t type, const ws::Font *f, const char *text)
+        {
+            const char *name    = f->get_name();
+            key->nType          = type;
+            key->pFont          = f;
+            key->pName          = (name != NULL) ? name : "";
+            key->nNameLen       = ::strlen(key->pName);
+            key->pText          = (text != NULL) ? text : "";
+            key->nTextLen       = ::strlen(key->pText);
+
+            // Compute FNV-1a hash of the key
+            float size          = f->get_size();
+            uint32_t h          = 0x811c9dc5;
+            uint32_t isize;
+            ::memcpy(&isize, &size, sizeof(isize));
+
+            h                   = (h ^ uint32_t(type)) * 0x01000193;
+            h                   = (h ^ isize) * 0x01000193;
+            h                   = (h ^ uint32_t(f->flags())) * 0x01000193;
+            h                   = (h ^ uint32_t(f->antialiasing())) * 0x01000193;
+            for (size_t i=0; i<key->nNameLen; ++i)
+                h                   = (h ^ uint8_t(key->pName[i])) * 0x01000193;
+            for (size_t i=0; i<key->nTextLen; ++i)
+                h                   = (h ^ uint8_t(key->pText[i])) * 0x01000193;
+
+            key->nHash          = h;
+        }
+
+        bool TextCache::matches(const item_t *item, const key_t *key)
+        {
+            const ws::Font *f   = key->pFont;
+
+            return  (item->nHash == key->nHash) &&
+                    (item->nType == key->nType) &&
+                    (item->fSize == f->get_size()) &&
+                    (item->nFlags == f->flags()) &&
+                    (item->nAntialias == size_t(f->antialiasing())) &&
+                    (item->nNameLen == key->nNameLen) &&
+                    (item->nTextLen == key->nTextLen) &&
+                    (::memcmp(item->pKey, key->pName, key->nNameLen) == 0) &&
+                    (::memcmp(&item->pKey[key->nNameLen], key->pText, key->nTextLen) == 0);
+        }
+
+        void TextCache::unlink(item_t *item)
+        {
+            // Remove from the hash bin
+            for (item_t **pi = &vBins[item->nHash & (TEXT_CACHE_BINS - 1)]; *pi != NULL; pi = &(*pi)->pBinNext)
+            {
+                if (*pi == item)
+                {
+                    *pi             = item->pBinNext;
+                    break;
+                }
+            }
+
+            // Remove from the LRU list
+            if (item->pPrev != NULL)
+                item->pPrev->pNext  = item->pNext;
+            else
+                pHead               = item->pNext;
+            if (item->pNext != NULL)
+                item->pNext->pPrev  = item->pPrev;
+            else
+                pTail               = item->pPrev;
+
+            --nItems;
+        }
+
+        void TextCache::shrink(size_t items)
+        {
+            while ((pTail != NULL) && (nItems > items))
+            {
+                item_t *item    = pTail;
+                unlink(item);
+                ::free(item);
+            }
+        }
+
+        void TextCache::clear()
+        {
+            shrink(0);
+        }
+
+        void TextCache::set_capacity(size_t items)
+        {
+            nCapacity       = items;
+            shrink(nCapacity);
+        }
+
+        TextCache::item_t *TextCache::lookup(const key_t *key)
+        {
+            if (vBins != NULL)
+            {
+                for (item_t *item = vBins[key->nHash & (TEXT_CACHE_BINS - 1)]; item != NULL; item = item->pBinNext)
+                {
+                    if (!matches(item, key))
+                        continue;
+
+                    // Move item to the head of the LRU list
+                    if (item->pPrev != NULL)
+                    {
+                        item->pPrev->pNext  = item->pNext;
+                        if (item->pNext != NULL)
+                            item->pNext->pPrev  = item->pPrev;
+                        else
+                            pTail               = item->pPrev;
+
+                        item->pPrev         = NULL;
+                        item->pNext         = pHead;
+                        pHead->pPrev        = item;
+                        pHead               = item;
+                    }
+
+                    ++nHits;
+                    return item;
+                }
+            }
+
+            ++nMisses;
+            return NULL;
+        }
+
+        TextCache::item_t *TextCache::insert(const key_t *key)
+        {
+            if (nCapacity <= 0)
+                return NULL;
+
+            // Allocate bins and the new item
+            if (vBins == NULL)
+            {
+                vBins           = static_cast<item_t **>(::calloc(TEXT_CACHE_BINS, sizeof(item_t *)));
+                if (vBins == NULL)
+                    return NULL;
+            }
+
+            size_t bytes    = sizeof(item_t) + key->nNameLen + key->nTextLen;
+            item_t *item    = static_cast<item_t *>(::malloc(bytes));
+            if (item == NULL)
+                return NULL;
+
+            // Free space for the new item
+            shrink(nCapacity - 1);
+
+            // Fill the key
+            const ws::Font *f   = key->pFont;
+            item->nHash     = key->nHash;
+            item->nType     = key->nType;
+            item->fSize     = f->get_size();
+            item->nFlags    = f->flags();
+            item->nAntialias= f->antialiasing();
+            item->nNameLen  = key->nNameLen;
+            item->nTextLen  = key->nTextLen;
+            item->pKey      = reinterpret_cast<char *>(&item[1]);
+            ::memcpy(item->pKey, key->pName, key->nNameLen);
+            ::memcpy(&item->pKey[key->nNameLen], key->pText, key->nTextLen);
+
+            // Link the item
+            size_t bin      = item->nHash & (TEXT_CACHE_BINS - 1);
+            item->pPrev     = NULL;
+            item->pNext     = pHead;
+            item->pBinNext  = vBins[bin];
+
+            if (pHead != NULL)
+                pHead->pPrev    = item;
+            else
+                pTail           = item;
+            pHead           = item;
+            vBins[bin]      = item;
+            ++nItems;
+
+            return item;
+        }
+
+        bool TextCache::get_font_parameters(const ws::Font *f, ws::font_parameters_t *fp)
+        {
+            key_t key;
+            make_key(&key, E_FONT, f, NULL);
+            item_t *item    = lookup(&key);
+            if (item == NULL)
+                return false;
+
+            *fp             = item->sFP;
+            return true;
+        }
+
+        void TextCache::put_font_parameters(const ws::Font *f, const ws::font_parameters_t *fp)
+        {
+            key_t key;
+            make_key(&key, E_FONT, f, NULL);
+            item_t *item    = insert(&key);
+            if (item != NULL)
+                item->sFP       = *fp;
+        }
+
+        bool TextCache::get_text_parameters(const ws::Font *f, const char *text, ws::text_parameters_t *tp)
+        {
+            key_t key;
+            make_key(&key, E_TEXT, f, text);
+            item_t *item    = lookup(&key);
+            if (item == NULL)
+                return false;
+
+            *tp             = item->sTP;
+            return true;
+        }
+
+        void TextCache::put_text_parameters(const ws::Font *f, const char *text, const ws::text_parameters_t *tp)
+        {
+            key_t key;
+            make_key(&key, E_TEXT, f, text);
+            item_t *item    = insert(&key);
+            if (item != NULL)
+                item->sTP       = *tp;
+        }
+
+        bool TextCache::get_multitext_parameters(const ws::Font *f, const char *text, ws::text_parameters_t *tp)
+        {
+            key_t key;
+            make_key(&key, E_MULTITEXT, f, text);
+            item_t *item    = lookup(&key);
+            if (item == NULL)
+                return false;
+
+            *tp             = item->sTP;
+            return true;
+        }
+
+        void TextCache::put_multitext_parameters(const ws::Font *f, const char *text, const ws::text_parameters_t *tp)
+        {
+            key_t key;
+            make_key(&key, E_MULTITEXT, f, text);
+            item_t *item    = insert(&key);
+            if (item != NULL)
+                item->sTP       = *tp;
+        }
+    }
+}
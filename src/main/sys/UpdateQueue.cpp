@@ -0,0 +1,303 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-tk-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-tk-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-tk-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-tk-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <lsp-plug.in/tk/tk.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace lsp
+{
+    namespace tk
+    {
+        UpdateQueue::UpdateQueue()
+        {
+            vUnits          = NULL;
+            nUnits          = 0;
+            nHead           = 0;
+            nTail           = 0;
+        }
+
+        UpdateQueue::~UpdateQueue()
+        {
+            destroy();
+        }
+
+        status_t UpdateQueue::init(size_t size)
+        {
+            destroy();
+
+            size_t units    = lsp_max(size / sizeof(record_t), 2);
+            record_t *v     = static_cast<record_t *>(::malloc(units * sizeof(record_t)));
+            if (v == NULL)
+                return STATUS_NO_MEM;
+
+            vUnits          = v;
+            nUnits          = units;
+            nHead           = 0;
+            nTail           = 0;
+
+            return STATUS_OK;
+        }
+
+        void UpdateQueue::destroy()
+        {
+            if (vUnits != NULL)
+            {
+                ::free(vUnits);
+                vUnits          = NULL;
+            }
+
+            nUnits          = 0;
+            nHead           = 0;
+            nTail           = 0;
+            vPending.flush();
+        }
+
+        UpdateQueue::record_t *UpdateQueue::begin_record(size_t type, void *target, size_t count)
+        {
+            if (vUnits == NULL)
+                return NULL;
+
+            // Estimate the free space, one unit is always kept unused to distinguish
+            // the empty queue from the full one
+            size_t units    = 1 + (count * sizeof(float) + sizeof(record_t) - 1) / sizeof(record_t);
+            size_t head     = atomic_load(&nHead);
+            size_t tail     = nTail;
+            size_t free     = (head + nUnits - tail - 1) % nUnits;
+            size_t room     = nUnits - tail;
+            size_t need     = (units > room) ? units + room : units;
+            if (need > free)
+                return NULL;
+
+            // The record should not be split, skip the tail of the buffer if necessary
+            if (units > room)
+            {
+                record_t *skip  = &vUnits[tail];
+                skip->nType     = U_SKIP;
+                skip->nUnits    = room;
+                tail            = 0;
+            }
+
+            record_t *rec   = &vUnits[tail];
+            rec->nType      = type;
+            rec->nUnits     = units;
+            rec->nParam     = 0;
+            rec->nCount     = count;
+            rec->pTarget    = target;
+            rec->fValue     = 0.0f;
+            rec->nSeq       = 0;
+
+            return rec;
+        }
+
+        void UpdateQueue::end_record(record_t *rec)
+        {
+            size_t tail     = (rec - vUnits) + rec->nUnits;
+            if (tail >= nUnits)
+                tail           -= nUnits;
+
+            // Publish the record to the consumer
+            atomic_store(&nTail, tail);
+        }
+
+        bool UpdateQueue::post(Float *prop, float value)
+        {
+            record_t *rec   = begin_record(U_FLOAT, prop, 0);
+            if (rec == NULL)
+                return false;
+
+            rec->fValue     = value;
+            end_record(rec);
+            return true;
+        }
+
+        bool UpdateQueue::post(RangeFloat *prop, float value)
+        {
+            record_t *rec   = begin_record(U_RANGE_FLOAT, prop, 0);
+            if (rec == NULL)
+                return false;
+
+            rec->fValue     = value;
+            end_record(rec);
+            return true;
+        }
+
+        bool UpdateQueue::post(FloatArray *prop, const float *v, size_t count)
+        {
+            record_t *rec   = begin_record(U_FLOAT_ARRAY, prop, count);
+            if (rec == NULL)
+                return false;
+
+            ::memcpy(&rec[1], v, count * sizeof(float));
+            end_record(rec);
+            return true;
+        }
+
+        bool UpdateQueue::post(GraphMeshData *prop, const float *x, const float *y, size_t size)
+        {
+            record_t *rec   = begin_record(U_MESH, prop, size * 2);
+            if (rec == NULL)
+                return false;
+
+            float *dst      = reinterpret_cast<float *>(&rec[1]);
+            ::memcpy(dst, x, size * sizeof(float));
+            ::memcpy(&dst[size], y, size * sizeof(float));
+            rec->nParam     = size;
+            end_record(rec);
+            return true;
+        }
+
+        bool UpdateQueue::post(GraphFrameData *prop, uint32_t id, const float *row, size_t columns)
+        {
+            record_t *rec   = begin_record(U_FRAME_ROW, prop, columns);
+            if (rec == NULL)
+                return false;
+
+            ::memcpy(&rec[1], row, columns * sizeof(float));
+            rec->nParam     = id;
+            end_record(rec);
+            return true;
+        }
+
+        ssize_t UpdateQueue::cmp_records(const record_t *a, const record_t *b)
+        {
+            if (a->pTarget != b->pTarget)
+                return (a->pTarget < b->pTarget) ? -1 : 1;
+            if (a->nType != b->nType)
+                return (a->nType < b->nType) ? -1 : 1;
+            if ((a->nType == U_FRAME_ROW) && (a->nParam != b->nParam))
+                return (a->nParam < b->nParam) ? -1 : 1;
+            return ssize_t(a->nSeq) - ssize_t(b->nSeq);
+        }
+
+        void UpdateQueue::apply(record_t *rec)
+        {
+            const float *data   = reinterpret_cast<const float *>(&rec[1]);
+
+            switch (rec->nType)
+            {
+                case U_FLOAT:
+                    static_cast<Float *>(rec->pTarget)->set(rec->fValue);
+                    break;
+                case U_RANGE_FLOAT:
+                    static_cast<RangeFloat *>(rec->pTarget)->set(rec->fValue);
+                    break;
+                case U_FLOAT_ARRAY:
+                    static_cast<FloatArray *>(rec->pTarget)->set(data, rec->nCount);
+                    break;
+                case U_MESH:
+                    static_cast<GraphMeshData *>(rec->pTarget)->set(data, &data[rec->nParam], rec->nParam);
+                    break;
+                case U_FRAME_ROW:
+                    static_cast<GraphFrameData *>(rec->pTarget)->set_row(rec->nParam, data, rec->nCount);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        size_t UpdateQueue::drain()
+        {
+            if (vUnits == NULL)
+                return 0;
+
+            size_t head     = nHead;
+            size_t tail     = atomic_load(&nTail);
+            if (head == tail)
+                return 0;
+
+            // Collect pending records, the records between head and tail
+            // are owned by the consumer until the head is moved
+            bool coalesce   = true;
+            uint32_t seq    = 0;
+            vPending.clear();
+            for (size_t i=head; i != tail; )
+            {
+                record_t *rec   = &vUnits[i];
+                if (rec->nType != U_SKIP)
+                {
+                    rec->nSeq       = seq++;
+                    if ((coalesce) && (!vPending.add(rec)))
+                        coalesce        = false;
+                }
+                i              += rec->nUnits;
+                if (i >= nUnits)
+                    i              -= nUnits;
+            }
+
+            // Leave only the last update of each property
+            if ((coalesce) && (vPending.size() > 1))
+            {
+                vPending.qsort(cmp_records);
+                record_t *prev  = vPending.uget(0);
+                for (size_t i=1, n=vPending.size(); i<n; ++i)
+                {
+                    record_t *rec   = vPending.uget(i);
+                    if ((prev->pTarget == rec->pTarget) &&
+                        (prev->nType == rec->nType) &&
+                        ((prev->nType != U_FRAME_ROW) || (prev->nParam == rec->nParam)))
+                        prev->nType     = U_SKIP;
+                    prev            = rec;
+                }
+            }
+            vPending.clear();
+
+            // Apply updates in the order they have been posted
+            size_t applied  = 0;
+            for (size_t i=head; i != tail; )
+            {
+                record_t *rec   = &vUnits[i];
+                if (rec->nType != U_SKIP)
+                {
+                    apply(rec);
+                    ++applied;
+                }
+                i              += rec->nUnits;
+                if (i >= nUnits)
+                    i              -= nUnits;
+            }
+
+            // Release the space to the producer
+            atomic_store(&nHead, tail);
+
+            return applied;
+        }
+
+        void UpdateQueue::discard(const void *prop)
+        {
+            if (vUnits == NULL)
+                return;
+
+            size_t tail     = atomic_load(&nTail);
+            for (size_t i=nHead; i != tail; )
+            {
+                record_t *rec   = &vUnits[i];
+                if (rec->pTarget == prop)
+                    rec->nType      = U_SKIP;
+                i              += rec->nUnits;
+                if (i >= nUnits)
+                    i              -= nUnits;
+            }
+        }
+    }
+}
@@ -101,12 +101,7 @@ namespace lsp
 
         void Area3D::drop_glass()
         {
-            if (pGlass != NULL)
-            {
-                pGlass->destroy();
-                delete pGlass;
-                pGlass = NULL;
-            }
+            drop_surface(&pGlass);
         }
 
         void Area3D::drop_backend()
@@ -342,7 +337,7 @@ namespace lsp
 
                 if (sGlass.get())
                 {
-                    cv = create_border_glass(&pGlass, s,
+                    cv = create_border_glass(pDisplay->surface_pool(), &pGlass, s,
                             color, bg_color,
                             SURFMASK_ALL_CORNER, bw, xr,
                             sSize.nWidth, sSize.nHeight, flat
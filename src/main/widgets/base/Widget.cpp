@@ -63,7 +63,9 @@ namespace lsp
         //---------------------------------------------------------------------
         void Widget::PropListener::notify(Property *prop)
         {
-            if (pWidget->valid())
+            if (!pWidget->valid())
+                return;
+            if (!pWidget->defer_property(prop))
                 pWidget->property_changed(prop);
         }
 
@@ -84,10 +86,12 @@ namespace lsp
             sPointer(&sProperties),
             sTag(&sProperties)
         {
-            nFlags                  = REDRAW_SURFACE | SIZE_INVALID | RESIZE_PENDING;
+            nFlags                  = REDRAW_SURFACE | SURFACE_INVALID | SIZE_INVALID | RESIZE_PENDING;
             pClass                  = &metadata;
             pDisplay                = dpy;
             pParent                 = NULL;
+            pBuildList              = NULL;
+            nBuildIndex             = 0;
 
             sLimit.nMinWidth        = -1;
             sLimit.nMinHeight       = -1;
@@ -140,6 +144,15 @@ namespace lsp
 
             // Initialize style
             status_t res = sStyle.init();
+            if ((res == STATUS_OK) && (pDisplay->building()))
+            {
+                // Collect style notifications until the build is finished
+                if ((res = sStyle.begin()) == STATUS_OK)
+                {
+                    if (!defer_build(BUILD_STYLE))
+                        res = sStyle.end();
+                }
+            }
             if (res == STATUS_OK)
             {
                 sAllocation.bind("allocation", &sStyle);
@@ -198,17 +211,18 @@ namespace lsp
             if (wnd != NULL)
                 wnd->discard_widget(this);
 
+            // Drop requests deferred by the build
+            if (nFlags & BUILD_PENDING)
+                pDisplay->cancel_build(this);
+            nFlags     &= ~BUILD_MASK;
+            vBuildProps.flush();
+
             // Set parent widget to NULL
             set_parent(NULL);
             sStyle.destroy();
 
             // Destroy surface
-            if (pSurface != NULL)
-            {
-                pSurface->destroy();
-                delete pSurface;
-                pSurface = NULL;
-            }
+            drop_surface(&pSurface);
 
             // Execute slots and unbind all to prevent duplicate on_destroy calls
             sSlots.execute(SLOT_DESTROY, this);
@@ -226,13 +240,13 @@ namespace lsp
             if (sBgBrightness.is(prop))
                 query_draw(REDRAW_CHILD | REDRAW_SURFACE);
             if (sPadding.is(prop))
-                query_resize();
+                query_parent_resize();
             if (sBgColor.is(prop))
                 query_draw(REDRAW_CHILD | REDRAW_SURFACE);
             if (sBgInherit.is(prop))
                 query_draw(REDRAW_CHILD | REDRAW_SURFACE);
             if (sAllocation.is(prop))
-                query_resize();
+                query_parent_resize();
             if (sVisibility.is(prop))
             {
                 if (sVisibility.get())
@@ -491,12 +505,10 @@ namespace lsp
                 wnd->discard_widget(this);
 
             // Drop surface to not to eat memory
-            if (pSurface != NULL)
-            {
-                pSurface->destroy();
-                delete pSurface;
-                pSurface = NULL;
-            }
+            drop_surface(&pSurface);
+
+            // The layout of hidden widget becomes invalid
+            nFlags     |= (RESIZE_PENDING | SIZE_INVALID);
 
             // Execute slot
             sSlots.execute(SLOT_HIDE, this);
@@ -551,10 +563,31 @@ namespace lsp
                 return;
 
             // Check that flags have been changed
-            flags       = nFlags | (flags & (REDRAW_CHILD | REDRAW_SURFACE));
+            flags      &= (REDRAW_CHILD | REDRAW_SURFACE);
+
+            // Defer the request while building
+            if ((flags) && (defer_build((flags & REDRAW_SURFACE) ? BUILD_DRAW | BUILD_DRAW_SURF : BUILD_DRAW)))
+                return;
+
+            if (flags & REDRAW_SURFACE)
+                flags      |= SURFACE_INVALID;
+            flags      |= nFlags;
             if (flags == nFlags)
                 return;
 
+            // Report the area occupied by the widget as damaged
+            if ((flags ^ nFlags) & REDRAW_SURFACE)
+            {
+                Window *wnd = widget_cast<Window>(toplevel());
+                if ((wnd != NULL) && (wnd != this))
+                {
+                    ws::rectangle_t r;
+                    get_padded_rectangle(&r);
+                    if (!Size::is_empty(&r))
+                        wnd->query_damage(&r);
+                }
+            }
+
             // Update flags and call parent
             nFlags      = flags;
             if (pParent != NULL)
@@ -589,12 +622,48 @@ namespace lsp
                 return;
 
             // Update flags
-            nFlags     |= (RESIZE_PENDING | SIZE_INVALID);
+            size_t flags    = nFlags;
+            nFlags         |= (RESIZE_PENDING | SIZE_INVALID);
 
             if (!sVisibility.get())
                 return;
+            if (pParent == NULL)
+                return;
 
-            if (pParent != NULL)
+            // Propagate the request to the parent when the build is finished
+            if (defer_build(BUILD_RESIZE))
+                return;
+
+            // The realized widget is a relayout boundary if it's size limits did not change:
+            // the allocation provided by the parent remains the same, so it is enough
+            // to realize the widget itself once again instead of the whole window.
+            // The widget already queued as a boundary is measured once again: it remains
+            // the boundary while it's size limits match the allocated ones
+            if ((!(flags & FINALIZED)) && (!(pParent->nFlags & RESIZE_PENDING)))
+            {
+                Window *wnd     = widget_cast<Window>(toplevel());
+                if ((wnd != NULL) &&
+                    ((!(flags & (RESIZE_PENDING | SIZE_INVALID))) || (wnd->relayout_pending(this))))
+                {
+                    ws::size_limit_t old = sLimit, l;
+                    get_size_limits(&l);
+                    if (SizeConstraints::equals(&old, &l))
+                    {
+                        wnd->query_relayout(this);
+                        return;
+                    }
+                }
+            }
+
+            pParent->query_resize();
+        }
+
+        void Widget::query_parent_resize()
+        {
+            // Padding and allocation do not affect the size limits of the widget
+            // but affect the layout of the parent widget
+            query_resize();
+            if ((sVisibility.get()) && (pParent != NULL))
                 pParent->query_resize();
         }
 
@@ -622,11 +691,7 @@ namespace lsp
             if (pSurface != NULL)
             {
                 if ((width != ssize_t(pSurface->width())) || (height != ssize_t(pSurface->height())))
-                {
-                    pSurface->destroy();
-                    delete pSurface;
-                    pSurface    = NULL;
-                }
+                    drop_surface(&pSurface);
             }
 
             // Create new surface if needed
@@ -639,19 +704,20 @@ namespace lsp
                 if ((width <= 0) || (height <= 0))
                     return NULL;
 
-                pSurface        = s->create(width, height);
+                pSurface        = pDisplay->surface_pool()->acquire(s, width, height);
                 if (pSurface == NULL)
                     return NULL;
-                nFlags         |= REDRAW_SURFACE;
+                nFlags         |= SURFACE_INVALID;
             }
 
-            // Redraw surface if required
-            if (nFlags & REDRAW_SURFACE)
+            // Redraw surface if required. The REDRAW_SURFACE flag may be already
+            // committed by the parent if the widget was outside of the damaged area
+            if (nFlags & (REDRAW_SURFACE | SURFACE_INVALID))
             {
                 pSurface->begin();
                     draw(pSurface);
                 pSurface->end();
-                nFlags         &= ~REDRAW_SURFACE;
+                nFlags         &= ~(REDRAW_SURFACE | SURFACE_INVALID);
             }
 
             return pSurface;
@@ -661,6 +727,15 @@ namespace lsp
         {
         }
 
+        void Widget::drop_surface(ws::ISurface **s)
+        {
+            if (*s == NULL)
+                return;
+
+            pDisplay->surface_pool()->release(*s);
+            *s      = NULL;
+        }
+
         void Widget::realize(const ws::rectangle_t *r)
         {
             // Do not report size request on size change
@@ -672,7 +747,8 @@ namespace lsp
 
             // Execute slot and commit size
             ws::rectangle_t xr = *r;
-            sSlots.execute(SLOT_RESIZE, this, &xr);
+            if (!defer_build(BUILD_RESIZED))
+                sSlots.execute(SLOT_RESIZE, this, &xr);
             sSize        = *r;
         }
 
@@ -689,7 +765,95 @@ namespace lsp
 
             // Send Realized() event
             ws::rectangle_t rm = *r;
-            sSlots.execute(SLOT_REALIZED, this, &rm);
+            if (!defer_build(BUILD_REALIZED))
+                sSlots.execute(SLOT_REALIZED, this, &rm);
+        }
+
+        bool Widget::defer_build(size_t flags)
+        {
+            if ((pDisplay == NULL) || (!pDisplay->building()))
+                return false;
+
+            if (!(nFlags & BUILD_PENDING))
+            {
+                if (!pDisplay->add_build(this))
+                    return false;
+                nFlags     |= BUILD_PENDING;
+            }
+
+            nFlags     |= flags;
+            return true;
+        }
+
+        bool Widget::defer_property(Property *prop)
+        {
+            if ((!(nFlags & BUILD_PROPS)) || (vBuildProps.index_of(prop) < 0))
+            {
+                if (!pDisplay->building())
+                    return false;
+                if (!vBuildProps.add(prop))
+                    return false;
+                if (!defer_build(BUILD_PROPS))
+                {
+                    vBuildProps.pop();
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        void Widget::commit_build_style()
+        {
+            // Notifications issued by the style are collected as property notifications
+            if (nFlags & BUILD_STYLE)
+            {
+                nFlags     &= ~BUILD_STYLE;
+                sStyle.end();
+            }
+
+            // Handlers may change other properties, repeat until there are no changes
+            while (nFlags & BUILD_PROPS)
+            {
+                lltl::parray<Property> props;
+                props.swap(vBuildProps);
+                nFlags     &= ~BUILD_PROPS;
+
+                for (size_t i=0, n=props.size(); i<n; ++i)
+                {
+                    if (!valid())
+                        return;
+                    property_changed(props.uget(i));
+                }
+            }
+        }
+
+        void Widget::commit_build()
+        {
+            // Deliver notifications left after the style has been committed
+            commit_build_style();
+
+            size_t flags    = nFlags;
+            nFlags         &= ~BUILD_MASK;
+
+            // Emit pending events with the actual size of the widget
+            ws::rectangle_t r;
+            if (flags & BUILD_RESIZED)
+            {
+                r               = sSize;
+                sSlots.execute(SLOT_RESIZE, this, &r);
+            }
+            if (flags & BUILD_REALIZED)
+            {
+                r               = sSize;
+                sSlots.execute(SLOT_REALIZED, this, &r);
+            }
+
+            // Issue pending requests
+            if (flags & BUILD_RESIZE)
+                query_resize();
+            if (flags & BUILD_DRAW)
+                query_draw((flags & BUILD_DRAW_SURF) ? REDRAW_CHILD | REDRAW_SURFACE : REDRAW_CHILD);
         }
 
         void Widget::get_size_limits(ws::size_limit_t *l)
@@ -831,16 +995,14 @@ namespace lsp
 
             if ((!sBgInherit.get()) || (pParent == NULL))
             {
-                color->copy(sBgColor.color());
-                color->scale_lch_luminance(brightness);
+                color->copy(sBgColor.bright_color(brightness));
                 return;
             }
 
             WidgetContainer *pw = widget_cast<WidgetContainer>(pParent);
             if (pw == NULL)
             {
-                color->copy(sBgColor.color());
-                color->scale_lch_luminance(brightness);
+                color->copy(sBgColor.bright_color(brightness));
                 return;
             }
 
@@ -66,12 +66,41 @@ namespace lsp
             LSP_TK_BUILTIN_STYLE(ListBox, "ListBox", "root");
         }
 
+        IListBoxModel::~IListBoxModel()
+        {
+        }
+
+        size_t IListBoxModel::rows()
+        {
+            return 0;
+        }
+
+        status_t IListBoxModel::format(LSPString *dst, size_t row)
+        {
+            dst->clear();
+            return STATUS_OK;
+        }
+
+        bool IListBoxModel::selected(size_t row)
+        {
+            return false;
+        }
+
+        void IListBoxModel::select(size_t row, bool selected)
+        {
+        }
+
+        void IListBoxModel::unselect_all()
+        {
+        }
+
         const w_class_t ListBox::metadata               = { "ListBox", &WidgetContainer::metadata };
 
         ListBox::ListBox(Display *dpy):
             WidgetContainer(dpy),
             sHBar(dpy),
             sVBar(dpy),
+            sModelItem(dpy),
             vItems(&sProperties, &sIListener),
             vSelected(&sProperties, &sIListener),
             sSizeConstraints(&sProperties),
@@ -96,6 +125,11 @@ namespace lsp
             nLastIndex      = -1;
             nKeyScroll      = SCR_NONE;
 
+            pModel          = NULL;
+            nRowHeight      = 0;
+            nRowStep        = 0;
+            nModelWidth     = 0;
+
             sArea.nLeft     = 0;
             sArea.nTop      = 0;
             sArea.nWidth    = 0;
@@ -139,12 +173,16 @@ namespace lsp
             vSelected.flush();
             vVisible.flush();
 
+            pModel              = NULL;
+
             // Cleanup relations
             sHBar.set_parent(NULL);
             sVBar.set_parent(NULL);
+            sModelItem.set_parent(NULL);
 
             sHBar.destroy();
             sVBar.destroy();
+            sModelItem.destroy();
         }
 
         status_t ListBox::init()
@@ -157,9 +195,13 @@ namespace lsp
                 result  = sHBar.init();
             if (result == STATUS_OK)
                 result  = sVBar.init();
+            if (result == STATUS_OK)
+                result  = sModelItem.init();
             if (result != STATUS_OK)
                 return result;
 
+            sModelItem.set_parent(this);
+
             sIListener.bind_all(this, on_add_item, on_remove_item);
             sKeyTimer.bind(pDisplay);
             sKeyTimer.set_handler(key_scroll_handler, self());
@@ -256,6 +298,12 @@ namespace lsp
             alloc->wMinW        = 0;
             alloc->wMinH        = 0;
 
+            if (pModel != NULL)
+            {
+                allocate_model(alloc);
+                return;
+            }
+
             LSPString s;
             ws::font_parameters_t fp;
             ws::text_parameters_t tp;
@@ -301,6 +349,31 @@ namespace lsp
             }
         }
 
+        void ListBox::allocate_model(alloc_t *alloc)
+        {
+            float scaling       = lsp_max(0.0f, sScaling.get());
+            float fscaling      = lsp_max(0.0f, scaling * sFontScaling.get());
+            ssize_t spacing     = lsp_max(0.0f, scaling * sSpacing.get());
+
+            ws::font_parameters_t fp;
+            sFont.get_parameters(pDisplay, fscaling, &fp);
+
+            // All rows of the model have the same height, only the width of rows
+            // depends on the text, it is measured when the rows are drawn
+            ws::rectangle_t xr;
+            xr.nLeft        = 0;
+            xr.nTop         = 0;
+            xr.nWidth       = 0;
+            xr.nHeight      = fp.Height;
+            sModelItem.padding()->add(&xr, scaling);
+
+            nRowHeight      = xr.nHeight;
+            nRowStep        = xr.nHeight + spacing;
+
+            alloc->wMinW    = lsp_max(xr.nWidth, nModelWidth);
+            alloc->wMinH    = pModel->rows() * nRowStep;
+        }
+
         void ListBox::size_request(ws::size_limit_t *r)
         {
             alloc_t a;
@@ -450,12 +523,20 @@ namespace lsp
             realize_children();
 
             // Update scrolling
-            item_t *curr    = find_by_index(nCurrIndex);
-            ssize_t start   = vVisible.index_of(curr);
-            if (start >= 0)
+            if (pModel != NULL)
             {
-                if (scroll_to_item(start))
-                    realize_children();
+                if (nCurrIndex >= 0)
+                    scroll_to_row(nCurrIndex);
+            }
+            else
+            {
+                item_t *curr    = find_by_index(nCurrIndex);
+                ssize_t start   = vVisible.index_of(curr);
+                if (start >= 0)
+                {
+                    if (scroll_to_item(start))
+                        realize_children();
+                }
             }
 
             // Call parent for realize
@@ -464,6 +545,13 @@ namespace lsp
 
         void ListBox::realize_children()
         {
+            // Rows of the model are positioned while drawing
+            if (pModel != NULL)
+            {
+                query_draw();
+                return;
+            }
+
             float scaling       = lsp_max(0.0f, sScaling.get());
             ssize_t spacing     = lsp_max(0.0f, scaling * sSpacing.get());
             ssize_t max_w       = sList.nWidth;
@@ -616,6 +704,9 @@ namespace lsp
                     sFont.get_parameters(pDisplay, fscaling, &fp);
 
                     s->clip_begin(&xa);
+                    if (pModel != NULL)
+                        render_model(s, &xa);
+
                     for (size_t i=0, n=vVisible.size(); i<n; ++i)
                     {
                         item_t *it = vVisible.get(i);
@@ -659,8 +750,86 @@ namespace lsp
             }
         }
 
+        void ListBox::render_model(ws::ISurface *s, const ws::rectangle_t *area)
+        {
+            float scaling       = lsp_max(0.0f, sScaling.get());
+            float fscaling      = lsp_max(0.0f, scaling * sFontScaling.get());
+            ssize_t rows        = pModel->rows();
+
+            sModelItem.commit_redraw();
+            if ((rows <= 0) || (nRowStep <= 0))
+                return;
+
+            // Compute the range of rows that are visible in the area
+            ssize_t top         = sList.nTop - ((sVBar.visibility()->get()) ? sVBar.value()->get() : 0);
+            ssize_t first       = lsp_max(0, (area->nTop - top) / nRowStep);
+            ssize_t last        = lsp_min(rows, (area->nTop + area->nHeight - top) / nRowStep + 1);
+
+            LSPString text;
+            lsp::Color col;
+            ws::rectangle_t xr, rr;
+            ws::font_parameters_t fp;
+            ws::text_parameters_t tp;
+            sFont.get_parameters(pDisplay, fscaling, &fp);
+            ssize_t width       = nModelWidth;
+
+            for (ssize_t i=first; i<last; ++i)
+            {
+                get_row_rect(&rr, i);
+                if (!Size::overlap(area, &rr)) // Do not draw invisible rows
+                    continue;
+
+                text.clear();
+                pModel->format(&text, i);
+                sModelItem.text_adjust()->apply(&text);
+                sFont.get_text_parameters(pDisplay, &tp, fscaling, &text);
+
+                if (pModel->selected(i))
+                {
+                    col.copy(sModelItem.bg_selected_color()->color());
+                    s->fill_rect(col, &rr);
+                    col.copy(sModelItem.text_selected_color()->color());
+                }
+                else
+                {
+                    sModelItem.get_actual_bg_color(col);
+                    s->fill_rect(col, &rr);
+                    col.copy(sModelItem.text_color()->color());
+                }
+
+                sModelItem.padding()->enter(&xr, &rr, scaling);
+                sFont.draw(s, col,
+                        xr.nLeft,
+                        xr.nTop  + ((xr.nHeight - fp.Height) * 0.5f) + fp.Ascent,
+                        fscaling, &text);
+
+                // Remember the width of the row
+                xr.nWidth           = tp.Width;
+                xr.nHeight          = 0;
+                sModelItem.padding()->add(&xr, scaling);
+                width               = lsp_max(width, xr.nWidth);
+            }
+
+            // Update the horizontal scrolling if the wider row has been found
+            if (width > nModelWidth)
+            {
+                nModelWidth         = width;
+                query_resize();
+            }
+        }
+
         void ListBox::keep_single_selection()
         {
+            if (pModel != NULL)
+            {
+                bool selected   = (nCurrIndex >= 0) && (size_t(nCurrIndex) < pModel->rows()) && (pModel->selected(nCurrIndex));
+                pModel->unselect_all();
+                if (selected)
+                    pModel->select(nCurrIndex, true);
+                query_draw();
+                return;
+            }
+
             lltl::parray<ListBoxItem> si;
             if (!vSelected.values(&si))
                 return;
@@ -820,10 +989,19 @@ namespace lsp
             if (nBMask != ws::MCF_LEFT)
                 return STATUS_OK;
 
-            item_t *it  = find_item(e->nLeft, e->nTop);
-            if (it != NULL)
+            ssize_t index   = -1;
+            if (pModel != NULL)
+                index           = find_row(e->nLeft, e->nTop);
+            else
             {
-                nCurrIndex      = it->index;
+                item_t *it      = find_item(e->nLeft, e->nTop);
+                if (it != NULL)
+                    index           = it->index;
+            }
+
+            if (index >= 0)
+            {
+                nCurrIndex      = index;
                 if (e->nState & ws::MCF_SHIFT)
                     select_range(nLastIndex, nCurrIndex, e->nState & ws::MCF_CONTROL);
                 else
@@ -960,14 +1138,28 @@ namespace lsp
             if (last < first)
                 swap(first, last);
 
-            for (; first <= last; ++first)
+            if (pModel != NULL)
             {
-                ListBoxItem *li = vItems.get(first);
-                if ((li == NULL) || (!li->visibility()->get()))
-                    continue;
+                first   = lsp_max(first, 0);
+                last    = lsp_min(last, ssize_t(pModel->rows()) - 1);
+                for (; first <= last; ++first)
+                {
+                    pModel->select(first, true);
+                    changed = true;
+                }
+                query_draw();
+            }
+            else
+            {
+                for (; first <= last; ++first)
+                {
+                    ListBoxItem *li = vItems.get(first);
+                    if ((li == NULL) || (!li->visibility()->get()))
+                        continue;
 
-                vSelected.add(li);
-                changed = true;
+                    vSelected.add(li);
+                    changed = true;
+                }
             }
 
             // Execute change
@@ -983,14 +1175,28 @@ namespace lsp
             bool changed = false;
             if ((!add) || (!sMultiSelect.get()))
             {
-                vSelected.clear();
+                if (pModel != NULL)
+                    pModel->unselect_all();
+                else
+                    vSelected.clear();
                 changed = true;
             }
-            ListBoxItem *it = vItems.get(index);
-            if (it != NULL)
+            if (pModel != NULL)
             {
-                vSelected.toggle(it);
-                changed = true;
+                if ((index >= 0) && (size_t(index) < pModel->rows()))
+                {
+                    pModel->select(index, !pModel->selected(index));
+                    changed = true;
+                }
+            }
+            else
+            {
+                ListBoxItem *it = vItems.get(index);
+                if (it != NULL)
+                {
+                    vSelected.toggle(it);
+                    changed = true;
+                }
             }
 
             // Execute change
@@ -1029,6 +1235,17 @@ namespace lsp
                 case ws::WSK_HOME:
                 case ws::WSK_KEYPAD_HOME:
                 {
+                    if (pModel != NULL)
+                    {
+                        if (pModel->rows() > 0)
+                        {
+                            nCurrIndex  = 0;
+                            select_single(nCurrIndex, false);
+                            scroll_to_row(nCurrIndex);
+                        }
+                        break;
+                    }
+
                     item_t *it  = vVisible.first();
                     if (it != NULL)
                     {
@@ -1042,6 +1259,17 @@ namespace lsp
                 case ws::WSK_END:
                 case ws::WSK_KEYPAD_END:
                 {
+                    if (pModel != NULL)
+                    {
+                        if (pModel->rows() > 0)
+                        {
+                            nCurrIndex  = pModel->rows() - 1;
+                            select_single(nCurrIndex, false);
+                            scroll_to_row(nCurrIndex);
+                        }
+                        break;
+                    }
+
                     item_t *it  = vVisible.last();
                     if (it != NULL)
                     {
@@ -1118,60 +1346,65 @@ namespace lsp
                 return STATUS_OK;
 
             float scaling   = lsp_max(0.0f, sScaling.get());
-            item_t *curr    = find_by_index(nCurrIndex);
-            ssize_t start   = lsp_max(-1, vVisible.index_of(curr));
-            ssize_t last    = vVisible.size() - 1;
-            ssize_t vindex  = start;
-
-            // Vertical scrolling
-            if (mask & (SCR_PGUP | SCR_KP_PGUP))
+            if (pModel != NULL)
+                scroll_model(mask);
+            else
             {
-                ssize_t amount  = sList.nHeight - curr->r.nHeight;
+                item_t *curr    = find_by_index(nCurrIndex);
+                ssize_t start   = lsp_max(-1, vVisible.index_of(curr));
+                ssize_t last    = vVisible.size() - 1;
+                ssize_t vindex  = start;
 
-                // Perform PG_UP and PG_DOWN scroll
-                if (nKeyScroll & (SCR_PGUP | SCR_KP_PGUP))
+                // Vertical scrolling
+                if (mask & (SCR_PGUP | SCR_KP_PGUP))
                 {
-                    while (vindex > 0)
+                    ssize_t amount  = sList.nHeight - curr->r.nHeight;
+
+                    // Perform PG_UP and PG_DOWN scroll
+                    if (nKeyScroll & (SCR_PGUP | SCR_KP_PGUP))
                     {
-                        curr        = vVisible.get(--vindex);
-                        amount     -= curr->r.nHeight;
-                        if (amount <= 0)
-                            break;
+                        while (vindex > 0)
+                        {
+                            curr        = vVisible.get(--vindex);
+                            amount     -= curr->r.nHeight;
+                            if (amount <= 0)
+                                break;
+                        }
                     }
-                }
-                else
-                {
-                    while (vindex < last)
+                    else
                     {
-                        curr        = vVisible.get(++vindex);
-                        amount     -= curr->r.nHeight;
-                        if (amount <= 0)
-                            break;
+                        while (vindex < last)
+                        {
+                            curr        = vVisible.get(++vindex);
+                            amount     -= curr->r.nHeight;
+                            if (amount <= 0)
+                                break;
+                        }
                     }
                 }
-            }
-            else if ((mask & SCR_UP) | (mask & SCR_KP_UP))
-            {
-                if (nKeyScroll & (SCR_UP | SCR_KP_UP))
+                else if ((mask & SCR_UP) | (mask & SCR_KP_UP))
                 {
-                    if (vindex > 0)
-                        --vindex;
+                    if (nKeyScroll & (SCR_UP | SCR_KP_UP))
+                    {
+                        if (vindex > 0)
+                            --vindex;
+                    }
+                    else
+                    {
+                        if (vindex < last)
+                            ++vindex;
+                    }
                 }
-                else
+
+                if (vindex != start)
                 {
-                    if (vindex < last)
-                        ++vindex;
+                    curr        = vVisible.uget(vindex);
+                    nCurrIndex  = curr->index;
+                    select_single(nCurrIndex, false);
+                    scroll_to_item(vindex);
                 }
             }
 
-            if (vindex != start)
-            {
-                curr        = vVisible.uget(vindex);
-                nCurrIndex  = curr->index;
-                select_single(nCurrIndex, false);
-                scroll_to_item(vindex);
-            }
-
             // Horizontal scrolling
             if ((mask & (SCR_LEFT | SCR_KP_LEFT)) && (sHBar.visibility()->get()))
             {
@@ -1210,6 +1443,129 @@ namespace lsp
             return true;
         }
 
+        void ListBox::scroll_model(size_t mask)
+        {
+            ssize_t last    = pModel->rows() - 1;
+            ssize_t start   = lsp_limit(nCurrIndex, -1, last);
+            ssize_t index   = start;
+
+            // Vertical scrolling
+            if (mask & (SCR_PGUP | SCR_KP_PGUP))
+            {
+                ssize_t amount  = (nRowStep > 0) ? lsp_max(1, (sList.nHeight - nRowHeight) / nRowStep) : 1;
+                if (nKeyScroll & (SCR_PGUP | SCR_KP_PGUP))
+                    index           = lsp_max(0, index - amount);
+                else
+                    index           = lsp_min(last, index + amount);
+            }
+            else if ((mask & SCR_UP) | (mask & SCR_KP_UP))
+            {
+                if (nKeyScroll & (SCR_UP | SCR_KP_UP))
+                {
+                    if (index > 0)
+                        --index;
+                }
+                else
+                {
+                    if (index < last)
+                        ++index;
+                }
+            }
+
+            if ((index != start) && (index >= 0))
+            {
+                nCurrIndex  = index;
+                select_single(nCurrIndex, false);
+                scroll_to_row(nCurrIndex);
+            }
+        }
+
+        void ListBox::get_row_rect(ws::rectangle_t *r, ssize_t row)
+        {
+            r->nLeft        = sList.nLeft;
+            r->nTop         = sList.nTop + row * nRowStep + ((nRowStep - nRowHeight) >> 1);
+            r->nWidth       = lsp_max(sList.nWidth, nModelWidth);
+            r->nHeight      = nRowHeight;
+
+            if (sHBar.visibility()->get())
+                r->nLeft       -= sHBar.value()->get();
+            if (sVBar.visibility()->get())
+                r->nTop        -= sVBar.value()->get();
+        }
+
+        ssize_t ListBox::find_row(ssize_t x, ssize_t y)
+        {
+            if ((pModel == NULL) || (nRowStep <= 0))
+                return -1;
+
+            // All rows have the same height, compute the index directly
+            ssize_t top     = sList.nTop - ((sVBar.visibility()->get()) ? sVBar.value()->get() : 0);
+            if (y < top)
+                return -1;
+            ssize_t row     = (y - top) / nRowStep;
+            if (size_t(row) >= pModel->rows())
+                return -1;
+
+            ws::rectangle_t r;
+            get_row_rect(&r, row);
+            return (Position::inside(&r, x, y)) ? row : -1;
+        }
+
+        bool ListBox::scroll_to_row(ssize_t row)
+        {
+            if (!sVBar.visibility()->get())
+                return false;
+            if ((pModel == NULL) || (row < 0) || (size_t(row) >= pModel->rows()))
+                return false;
+
+            ws::rectangle_t r;
+            get_row_rect(&r, row);
+
+            if (r.nTop < sList.nTop)
+                sVBar.value()->sub(sList.nTop - r.nTop);
+            else if ((r.nTop + r.nHeight) > (sList.nTop + sList.nHeight))
+                sVBar.value()->add(r.nTop + r.nHeight - sList.nTop - sList.nHeight);
+            else
+                return false;
+
+            query_draw();
+            return true;
+        }
+
+        void ListBox::set_model(IListBoxModel *model)
+        {
+            if (pModel == model)
+                return;
+
+            pModel          = model;
+            nCurrIndex      = -1;
+            nLastIndex      = -1;
+            nModelWidth     = 0;
+            vVisible.clear();
+
+            query_resize();
+        }
+
+        void ListBox::update_model()
+        {
+            if (pModel == NULL)
+                return;
+
+            ssize_t rows    = pModel->rows();
+            if (nCurrIndex >= rows)
+                nCurrIndex      = -1;
+            if (nLastIndex >= rows)
+                nLastIndex      = -1;
+
+            // Rows may be appended incrementally, keep the maximum width of rows
+            // estimated while rendering until the model is cleared to avoid jumps
+            // of the horizontal scroll range
+            if (rows <= 0)
+                nModelWidth     = 0;
+
+            query_resize();
+        }
+
         status_t ListBox::on_change()
         {
             return STATUS_OK;
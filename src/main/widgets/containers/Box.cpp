@@ -209,20 +209,33 @@ namespace lsp
             if (sSolid.get())
                 return NULL;
 
-            for (size_t i=0, n=vVisible.size(); i<n; ++i)
+            // Cells are sorted along the packing axis and do not overlap, so find the
+            // last cell which starts before the specified coordinate using binary search
+            bool horizontal = sOrientation.horizontal();
+            ssize_t pos     = (horizontal) ? x : y;
+            ssize_t first   = 0, last = vVisible.size() - 1;
+            while (first <= last)
             {
-                cell_t *w = vVisible.uget(i);
-                Widget *pw = w->pWidget;
-
-                if ((pw == NULL) || (!pw->is_visible_child_of(this)))
-                    continue;
-                if (!pw->visibility()->get())
-                    continue;
-                if (pw->inside(x, y))
-                    return pw;
+                ssize_t mid     = (first + last) >> 1;
+                cell_t *w       = vVisible.uget(mid);
+                ssize_t start   = (horizontal) ? w->a.nLeft : w->a.nTop;
+                if (start <= pos)
+                    first           = mid + 1;
+                else
+                    last            = mid - 1;
             }
+            if (last < 0)
+                return NULL;
+
+            cell_t *w       = vVisible.uget(last);
+            Widget *pw      = w->pWidget;
+
+            if ((pw == NULL) || (!pw->is_visible_child_of(this)))
+                return NULL;
+            if (!pw->visibility()->get())
+                return NULL;
 
-            return NULL;
+            return (pw->inside(x, y)) ? pw : NULL;
         }
 
         void Box::render(ws::ISurface *s, const ws::rectangle_t *area, bool force)
@@ -64,6 +64,11 @@ namespace lsp
             pClass          = &metadata;
             sAlloc.nRows    = 0;
             sAlloc.nCols    = 0;
+            sAlloc.nTag     = 0;
+            sAlloc.nHSpacing= 0;
+            sAlloc.nVSpacing= 0;
+            sAlloc.bTopology= true;
+            sAlloc.bEstimate= true;
         }
         
         Grid::~Grid()
@@ -89,6 +94,8 @@ namespace lsp
             vItems.flush();
 
             free_cells(&sAlloc);
+            sAlloc.vRows.flush();
+            sAlloc.vCols.flush();
         }
 
         void Grid::destroy()
@@ -125,6 +132,8 @@ namespace lsp
             cell->nRows     = 0;
             cell->nCols     = 0;
             cell->nTag      = 0;
+            cell->nMinWidth = -1;
+            cell->nMinHeight= -1;
 
             return cell;
         }
@@ -145,6 +154,7 @@ namespace lsp
 
             alloc->vCells.flush();
             alloc->vTable.flush();
+            alloc->bTopology    = true;
         }
 
         status_t Grid::init()
@@ -167,15 +177,24 @@ namespace lsp
         {
             WidgetContainer::property_changed(prop);
             if (sRows.is(prop))
+            {
+                sAlloc.bTopology    = true;
                 query_resize();
+            }
             if (sColumns.is(prop))
+            {
+                sAlloc.bTopology    = true;
                 query_resize();
+            }
             if (sHSpacing.is(prop))
                 query_resize();
             if (sVSpacing.is(prop))
                 query_resize();
             if (sOrientation.is(prop))
+            {
+                sAlloc.bTopology    = true;
                 query_resize();
+            }
             if (sConstraints.is(prop))
                 query_resize();
         }
@@ -189,17 +208,40 @@ namespace lsp
 
         Widget *Grid::find_widget(ssize_t x, ssize_t y)
         {
-            for (size_t i=0, n=sAlloc.vCells.size(); i<n; ++i)
+            if (sAlloc.vTable.is_empty())
+                return NULL;
+
+            // Lookup for the row and the column, then get the cell from the table
+            ssize_t row     = find_header(&sAlloc.vRows, y);
+            ssize_t col     = find_header(&sAlloc.vCols, x);
+            if ((row < 0) || (col < 0))
+                return NULL;
+
+            cell_t *w       = sAlloc.vTable.get(row * sAlloc.nCols + col);
+            if (w == NULL)
+                return NULL;
+            Widget *pw      = w->pWidget;
+            if ((pw == NULL) || (!pw->is_visible_child_of(this)))
+                return NULL;
+
+            return (pw->inside(x, y)) ? pw : NULL;
+        }
+
+        ssize_t Grid::find_header(lltl::darray<header_t> *hdr, ssize_t pos)
+        {
+            // Find the last header which starts before the specified position
+            ssize_t first   = 0, last = hdr->size() - 1;
+            while (first <= last)
             {
-                cell_t *w = sAlloc.vCells.uget(i);
-                Widget *pw = w->pWidget;
-                if ((pw == NULL) || (!pw->is_visible_child_of(this)))
-                    continue;
-                if (pw->inside(x, y))
-                    return pw;
+                ssize_t mid     = (first + last) >> 1;
+                header_t *h     = hdr->uget(mid);
+                if (h->nPos <= pos)
+                    first           = mid + 1;
+                else
+                    last            = mid - 1;
             }
 
-            return NULL;
+            return last;
         }
 
         void Grid::render(ws::ISurface *s, const ws::rectangle_t *area, bool force)
@@ -354,10 +396,12 @@ namespace lsp
             item->nTop      = top;
             item->nRows     = rows;
             item->nCols     = cols;
+            item->bVisible  = false;
 
             if (widget != NULL)
                 widget->set_parent(this);
 
+            sAlloc.bTopology    = true;
             query_resize();
             return STATUS_OK;
         }
@@ -383,56 +427,48 @@ namespace lsp
 
         void Grid::realize(const ws::rectangle_t *r)
         {
-            free_cells(&sAlloc);
-
 //            lsp_trace("this=%p, size={%d, %d, %d, %d}",
 //                    this, int(r->nLeft), int(r->nTop), int(r->nWidth), int(r->nHeight)
 //                );
 //
-            alloc_t a;
-            status_t res = allocate_cells(&a);
-            if (res != STATUS_OK)
-            {
-                free_cells(&a);
+            if (allocate_cells() != STATUS_OK)
                 return;
+
+            // Distribute the size between rows and columns starting from the estimated size
+            for (size_t i=0, n=sAlloc.vRows.size(); i<n; ++i)
+            {
+                header_t *h     = sAlloc.vRows.uget(i);
+                h->nSize        = h->nEstimate;
+            }
+            for (size_t i=0, n=sAlloc.vCols.size(); i<n; ++i)
+            {
+                header_t *h     = sAlloc.vCols.uget(i);
+                h->nSize        = h->nEstimate;
             }
 
-            // Distribute the size between rows and columns
-            distribute_size(&a.vCols, 0, a.nCols, r->nWidth);
-            distribute_size(&a.vRows, 0, a.nRows, r->nHeight);
+            distribute_size(&sAlloc.vCols, 0, sAlloc.vCols.size(), r->nWidth);
+            distribute_size(&sAlloc.vRows, 0, sAlloc.vRows.size(), r->nHeight);
 
             // Assign coordinates to cells
-            assign_coords(&a, r);
+            assign_coords(&sAlloc, r);
 
             // Realize widgets
-            realize_children(&a);
-
-            // Swap the actual data
-            sAlloc.vCells.swap(&a.vCells);
-            sAlloc.vTable.swap(&a.vTable);
-            sAlloc.vRows.swap(&a.vRows);
-            sAlloc.vCols.swap(&a.vCols);
-            sAlloc.nRows    = a.nRows;
-            sAlloc.nCols    = a.nCols;
+            realize_children(&sAlloc);
 
             // Call parent method to realize
             WidgetContainer::realize(r);
-
-            // Destroy the previously used data
-            free_cells(&a);
         }
 
         void Grid::size_request(ws::size_limit_t *r)
         {
-            alloc_t a;
             float scaling       = lsp_max(0.0f, sScaling.get());
 
-            // Allocate cells
-            allocate_cells(&a);
+            // Update cells
+            allocate_cells();
 
             // Estimate size
-            r->nMinWidth        = estimate_size(&a.vCols, 0, a.nCols);
-            r->nMinHeight       = estimate_size(&a.vRows, 0, a.nRows);
+            r->nMinWidth        = estimate_size(&sAlloc.vCols, 0, sAlloc.vCols.size());
+            r->nMinHeight       = estimate_size(&sAlloc.vRows, 0, sAlloc.vRows.size());
             r->nMaxWidth        = -1;
             r->nMaxHeight       = -1;
             r->nPreWidth        = -1;
@@ -441,9 +477,6 @@ namespace lsp
             // Apply size constraints
             sConstraints.apply(r, scaling);
 
-            free_cells(&a);
-
-
 //            lsp_trace("w={%d, %d}, h={%d, %d}",
 //                    int(r->nMinWidth), int(r->nMaxWidth), int(r->nMinHeight), int(r->nMaxHeight)
 //            );
@@ -693,27 +726,28 @@ namespace lsp
             if (!a->vCols.add_n(a->nCols))
                 return STATUS_NO_MEM;
 
-            // Get scaling and spacings
-            float scaling   = lsp_max(0.0f, sScaling.get());
-            size_t hspacing = lsp_max(0, scaling * sHSpacing.get());
-            size_t vspacing = lsp_max(0, scaling * sVSpacing.get());
-
-            // Initialize row and column descriptors
+            // Initialize row and column descriptors, spacings and flags are set by update_headers()
             for (size_t i=0; i<a->nRows; ++i)
             {
                 h               = a->vRows.uget(i);
+                h->nMin         = 0;
+                h->nEstimate    = 0;
                 h->nSize        = 0;
+                h->nPos         = 0;
                 h->nWeight      = 1;
-                h->nSpacing     = vspacing;
-                h->nFlags       = 0;
+                h->nSpacing     = 0;
+                h->nFlags       = F_DIRTY;
             }
             for (size_t i=0; i<a->nCols; ++i)
             {
                 h               = a->vCols.uget(i);
+                h->nMin         = 0;
+                h->nEstimate    = 0;
                 h->nSize        = 0;
+                h->nPos         = 0;
                 h->nWeight      = 1;
-                h->nSpacing     = hspacing;
-                h->nFlags       = 0;
+                h->nSpacing     = 0;
+                h->nFlags       = F_DIRTY;
             }
 
             // Remove empty rows and columns
@@ -788,16 +822,38 @@ namespace lsp
                 }
             }
 
-            // Mark last row and last column as non-spacing
-            if (a->nRows > 0)
+            return STATUS_OK;
+        }
+
+        void Grid::update_headers(alloc_t *a)
+        {
+            header_t *h;
+
+            // Get scaling and spacings
+            float scaling   = lsp_max(0.0f, sScaling.get());
+            size_t hspacing = lsp_max(0, scaling * sHSpacing.get());
+            size_t vspacing = lsp_max(0, scaling * sVSpacing.get());
+
+            if ((a->nHSpacing != hspacing) || (a->nVSpacing != vspacing))
+            {
+                a->nHSpacing    = hspacing;
+                a->nVSpacing    = vspacing;
+                a->bEstimate    = true;
+            }
+
+            // Update spacings, the last row and last column are non-spacing.
+            // Save the previous state of 'expand' and 'reduce' flags
+            for (size_t i=0, n=a->vRows.size(); i<n; ++i)
             {
-                h   = a->vRows.get(a->nRows - 1);
-                h->nSpacing     = 0;
+                h               = a->vRows.uget(i);
+                h->nSpacing     = ((i+1) < n) ? vspacing : 0;
+                h->nFlags       = (h->nFlags & F_DIRTY) | ((h->nFlags & F_ALLOC_MASK) << F_PREV_SHIFT);
             }
-            if (a->nCols > 0)
+            for (size_t i=0, n=a->vCols.size(); i<n; ++i)
             {
-                h   = a->vCols.get(a->nCols - 1);
-                h->nSpacing     = 0;
+                h               = a->vCols.uget(i);
+                h->nSpacing     = ((i+1) < n) ? hspacing : 0;
+                h->nFlags       = (h->nFlags & F_DIRTY) | ((h->nFlags & F_ALLOC_MASK) << F_PREV_SHIFT);
             }
 
             // Initialize 'expand' and 'reduce' flags
@@ -840,7 +896,23 @@ namespace lsp
                 }
             }
 
-            return STATUS_OK;
+            // Flags affect the distribution of size for multi-span cells
+            if (flags_changed(&a->vRows))
+                a->bEstimate    = true;
+            if (flags_changed(&a->vCols))
+                a->bEstimate    = true;
+        }
+
+        bool Grid::flags_changed(lltl::darray<header_t> *hdr)
+        {
+            for (size_t i=0, n=hdr->size(); i<n; ++i)
+            {
+                header_t *h     = hdr->uget(i);
+                if (((h->nFlags >> F_PREV_SHIFT) & F_ALLOC_MASK) != (h->nFlags & F_ALLOC_MASK))
+                    return true;
+            }
+
+            return false;
         }
 
         size_t Grid::estimate_size(lltl::darray<header_t> *hdr, size_t first, size_t count)
@@ -849,7 +921,7 @@ namespace lsp
             for (size_t i=0; i<count; ++i)
             {
                 header_t *h     = hdr->uget(first);
-                res            += h->nSize;
+                res            += h->nEstimate;
                 if ((++first) < count)
                     res            += h->nSpacing;
             }
@@ -882,22 +954,26 @@ namespace lsp
                 return;
             size_t left = size - width;
 
-            // Form list of items for size distribution excluding reduced (if possible)
-            lltl::parray<header_t> vl;
-            for (size_t k=0; k<count; ++k)
+            // Select items for size distribution excluding reduced (if possible)
+            size_t mask, match, selected;
+            if (expanded > 0)
             {
-                header_t *h     = vh->uget(first + k);
-                if (expanded > 0)
-                {
-                    if ((!(h->nFlags & F_REDUCE)) && (h->nFlags & F_EXPAND))
-                        vl.add(h);
-                }
-                else if (reduced >= count)
-                    vl.add(h);
-                else if (!(h->nFlags & F_REDUCE))
-                    vl.add(h);
+                mask        = F_EXPAND | F_REDUCE;
+                match       = F_EXPAND;
+                selected    = expanded;
+            }
+            else if (reduced >= count)
+            {
+                mask        = 0;
+                match       = 0;
+                selected    = count;
+            }
+            else
+            {
+                mask        = F_REDUCE;
+                match       = 0;
+                selected    = count - reduced;
             }
-            count   = vl.size();
 
             // Distribute size between selected items
             if (weight > 0)
@@ -906,7 +982,9 @@ namespace lsp
                 ssize_t total = 0;
                 for (size_t k=0; k<count; ++k)
                 {
-                    header_t *h     = vl.uget(k);
+                    header_t *h     = vh->uget(first + k);
+                    if ((h->nFlags & mask) != match)
+                        continue;
                     size_t delta    = (h->nSize * h->nWeight * left) / weight;
                     h->nSize       += delta;
                     total          += delta;
@@ -917,12 +995,14 @@ namespace lsp
             // Add equal size to each element
             if (left > 0)
             {
-                size_t delta    = left / count;
+                size_t delta    = left / selected;
                 if (delta > 0)
                 {
                     for (size_t k=0; k<count; ++k)
                     {
-                        header_t *h     = vl.uget(k);
+                        header_t *h     = vh->uget(first + k);
+                        if ((h->nFlags & mask) != match)
+                            continue;
                         h->nSize       += delta;
                         left           -= delta;
                     }
@@ -932,86 +1012,227 @@ namespace lsp
             // Distribute the non-distributed size
             for (size_t k=0; left > 0; k = (k+1) % count)
             {
-                header_t *h     = vl.uget(k);
+                header_t *h     = vh->uget(first + k);
+                if ((h->nFlags & mask) != match)
+                    continue;
                 h->nSize ++;
                 left --;
             }
         }
 
+        void Grid::mark_dirty(lltl::darray<header_t> *hdr, size_t first, size_t count)
+        {
+            for (size_t i=0; i<count; ++i)
+            {
+                header_t *h     = hdr->uget(first + i);
+                h->nFlags      |= F_DIRTY;
+            }
+        }
+
+        bool Grid::estimate_row(alloc_t *a, size_t row)
+        {
+            header_t *h     = a->vRows.uget(row);
+            ssize_t size    = 0;
+            h->nFlags      &= ~F_DIRTY;
+
+            for (size_t x=0, off=row * a->nCols; x < a->nCols; ++x, ++off)
+            {
+                cell_t *c       = a->vTable.uget(off);
+                if ((c->pWidget == NULL) || (c->nRows != 1) || (!c->pWidget->visibility()->get()))
+                    continue;
+                size            = lsp_max(size, c->nMinHeight);
+            }
+
+            if (h->nMin == size)
+                return false;
+            h->nMin         = size;
+            return true;
+        }
+
+        bool Grid::estimate_col(alloc_t *a, size_t col)
+        {
+            header_t *h     = a->vCols.uget(col);
+            ssize_t size    = 0;
+            h->nFlags      &= ~F_DIRTY;
+
+            for (size_t y=0, off=col; y < a->nRows; ++y, off += a->nCols)
+            {
+                cell_t *c       = a->vTable.uget(off);
+                if ((c->pWidget == NULL) || (c->nCols != 1) || (!c->pWidget->visibility()->get()))
+                    continue;
+                size            = lsp_max(size, c->nMinWidth);
+            }
+
+            if (h->nMin == size)
+                return false;
+            h->nMin         = size;
+            return true;
+        }
+
         status_t Grid::estimate_sizes(alloc_t *a)
         {
             ws::size_limit_t sr;
             header_t *h;
+            bool changed    = a->bEstimate;
 
-            // Estimate minimum row/column size for 1xN and Mx1 cells
+            // Update cached size limits of widgets and mark rows and columns
+            // which contain changed single-span cells as dirty
             for (size_t i=0, n=a->vCells.size(); i<n; ++i)
             {
                 cell_t *w       = a->vCells.uget(i);
                 if ((w->pWidget == NULL) || (!w->pWidget->visibility()->get()))
                     continue;
-                else if ((w->nRows != 1) && (w->nCols != 1))
-                    continue;
 
                 // Get size limits of the widget
                 w->pWidget->get_padded_size_limits(&sr);
+                ssize_t width   = lsp_max(0, sr.nMinWidth);
+                ssize_t height  = lsp_max(0, sr.nMinHeight);
 
-                if (w->nRows == 1)
+                if (w->nMinWidth != width)
                 {
-                    h               = a->vRows.uget(w->nTop);
-                    h->nSize        = lsp_max(h->nSize, sr.nMinHeight);
+                    w->nMinWidth    = width;
+                    if (w->nCols == 1)
+                        mark_dirty(&a->vCols, w->nLeft, 1);
+                    else
+                        changed         = true;
                 }
-                if (w->nCols == 1)
+                if (w->nMinHeight != height)
                 {
-                    h               = a->vCols.uget(w->nLeft);
-                    h->nSize        = lsp_max(h->nSize, sr.nMinWidth);
+                    w->nMinHeight   = height;
+                    if (w->nRows == 1)
+                        mark_dirty(&a->vRows, w->nTop, 1);
+                    else
+                        changed         = true;
                 }
             }
 
+            // Estimate minimum row/column size for 1xN and Mx1 cells of dirty rows and columns only
+            for (size_t i=0, n=a->vRows.size(); i<n; ++i)
+            {
+                h               = a->vRows.uget(i);
+                if ((h->nFlags & F_DIRTY) && (estimate_row(a, i)))
+                    changed         = true;
+            }
+            for (size_t i=0, n=a->vCols.size(); i<n; ++i)
+            {
+                h               = a->vCols.uget(i);
+                if ((h->nFlags & F_DIRTY) && (estimate_col(a, i)))
+                    changed         = true;
+            }
+
+            // Nothing has changed since the previous estimation?
+            if (!changed)
+                return STATUS_OK;
+
+            for (size_t i=0, n=a->vRows.size(); i<n; ++i)
+            {
+                h               = a->vRows.uget(i);
+                h->nSize        = h->nMin;
+            }
+            for (size_t i=0, n=a->vCols.size(); i<n; ++i)
+            {
+                h               = a->vCols.uget(i);
+                h->nSize        = h->nMin;
+            }
+
             // Estimate minimum row/column size for N x M cells
             for (size_t i=0, n=a->vCells.size(); i<n; ++i)
             {
                 cell_t *w       = a->vCells.uget(i);
                 if ((w->pWidget == NULL) || (!w->pWidget->visibility()->get()))
                     continue;
-                if ((w->nRows <= 1) && (w->nCols <= 1))
-                    continue;
 
-                // Get size limits of the widget
-                w->pWidget->get_padded_size_limits(&sr);
+                if ((w->nRows > 1) && (w->nMinHeight > 0))
+                    distribute_size(&a->vRows, w->nTop,  w->nRows, w->nMinHeight);
+                if ((w->nCols > 1) && (w->nMinWidth > 0))
+                    distribute_size(&a->vCols, w->nLeft, w->nCols, w->nMinWidth);
+            }
 
-                if ((w->nRows > 1) && (sr.nMinHeight > 0))
-                {
-                    if (sr.nMinHeight > 0)
-                        distribute_size(&a->vRows, w->nTop,  w->nRows, sr.nMinHeight);
-                }
-                if ((w->nCols > 1) && (sr.nMinWidth > 0))
+            // Commit the estimation
+            for (size_t i=0, n=a->vRows.size(); i<n; ++i)
+            {
+                h               = a->vRows.uget(i);
+                h->nEstimate    = h->nSize;
+            }
+            for (size_t i=0, n=a->vCols.size(); i<n; ++i)
+            {
+                h               = a->vCols.uget(i);
+                h->nEstimate    = h->nSize;
+            }
+            a->bEstimate    = false;
+
+            return STATUS_OK;
+        }
+
+        bool Grid::check_topology()
+        {
+            bool changed    = sAlloc.bTopology;
+
+            // Visibility of widgets affects the set of rows and columns
+            for (size_t i=0, n=vItems.size(); i<n; ++i)
+            {
+                widget_t *w     = vItems.uget(i);
+                bool visible    = !hidden_widget(w);
+                if (w->bVisible != visible)
                 {
-                    if (sr.nMinWidth > 0)
-                        distribute_size(&a->vCols, w->nLeft, w->nCols, sr.nMinWidth);
+                    w->bVisible     = visible;
+                    changed         = true;
                 }
             }
 
-            return STATUS_OK;
+            return changed;
         }
 
-        status_t Grid::allocate_cells(alloc_t *a)
+        status_t Grid::build_topology(alloc_t *a)
         {
+            free_cells(a);
+            a->vRows.clear();
+            a->vCols.clear();
+
             // Attach cells
             status_t res    = attach_cells(a);
-            if ((res != STATUS_OK) || (a->nRows < 1) || (a->nCols < 1))
-                return res;
+            if (res == STATUS_OK)
+            {
+                if (a->vTable.is_empty())
+                {
+                    a->nRows        = 0;
+                    a->nCols        = 0;
+                }
+                else
+                    res             = create_row_col_descriptors(a);
+            }
 
-            // Estimate row and column parameters
-            if ((res = create_row_col_descriptors(a)) != STATUS_OK)
+            if (res != STATUS_OK)
+            {
+                free_cells(a);
+                a->vRows.clear();
+                a->vCols.clear();
                 return res;
+            }
 
-            // Estimate cell sizes
-            if ((res = estimate_sizes(a)) != STATUS_OK)
-                return res;
+            a->bTopology    = false;
+            a->bEstimate    = true;
 
             return STATUS_OK;
         }
 
+        status_t Grid::allocate_cells()
+        {
+            // Rebuild the topology of cells only when it has been changed
+            if (check_topology())
+            {
+                status_t res    = build_topology(&sAlloc);
+                if (res != STATUS_OK)
+                    return res;
+            }
+
+            // Estimate row and column parameters
+            update_headers(&sAlloc);
+
+            // Estimate cell sizes
+            return estimate_sizes(&sAlloc);
+        }
+
         void Grid::assign_coords(alloc_t *a, const ws::rectangle_t *r)
         {
             ssize_t y       = r->nTop;
@@ -1021,11 +1242,13 @@ namespace lsp
             {
                 header_t *vr    = a->vRows.uget(i);
                 ssize_t x       = r->nLeft;
+                vr->nPos        = y;
 
                 for (size_t j=0, m=a->vCols.size(); j<m; ++j, ++off)
                 {
                     header_t *hr    = a->vCols.uget(j);
                     cell_t *c       = a->vTable.uget(off);
+                    hr->nPos        = x;
 
                     // Allocate initial coordinates of the cell
                     if (c->nTag != a->nTag)
@@ -111,10 +111,6 @@ namespace lsp
 
         status_t PopupWindow::post_init()
         {
-            // Bind redraw handler
-            sRedraw.bind(pDisplay->display());
-            sRedraw.set_handler(tmr_redraw_request, self());
-
             // Don't create native window
             return STATUS_OK;
         }
@@ -25,6 +25,8 @@
 #include <lsp-plug.in/common/status.h>
 #include <private/tk/style/BuiltinStyle.h>
 
+#define MAX_DAMAGE_REGIONS      16
+
 namespace lsp
 {
     namespace tk
@@ -43,6 +45,7 @@ namespace lsp
                 sConstraints.bind("size.constraints", this);
                 sLayout.bind("layout", this);
                 sPolicy.bind("policy", this);
+                sFrameRate.bind("frame.rate", this);
                 // Configure
                 sBorderColor.set("#000000");
                 sBorderStyle.set(ws::BS_SIZEABLE);
@@ -54,6 +57,7 @@ namespace lsp
                 sConstraints.set(-1, -1, -1, -1);
                 sLayout.set(0.0f, 0.0f, 0.0f, 0.0f);
                 sPolicy.set(WP_NORMAL);
+                sFrameRate.set(25.0f);
                 // Override
                 sVisibility.set(false);
                 // Commit
@@ -77,7 +81,8 @@ namespace lsp
             sWindowSize(&sProperties),
             sSizeConstraints(&sProperties),
             sLayout(&sProperties),
-            sPolicy(&sProperties)
+            sPolicy(&sProperties),
+            sFrameRate(&sProperties)
         {
             lsp_trace("native_handle = %p", handle);
 
@@ -87,8 +92,14 @@ namespace lsp
             pNativeHandle   = handle;
             bMapped         = false;
             bOverridePointer= false;
+            bFullDamage     = true;
             fScaling        = 1.0f;
             pActor          = NULL;
+            nNextFrame      = 0;
+            bMotion         = false;
+            nMotionTask     = -1;
+
+            ws::init_event(&sMotion);
 
             hMouse.nState   = 0;
             hMouse.nLeft    = 0;
@@ -142,6 +153,7 @@ namespace lsp
             sSizeConstraints.bind("size.constraints", &sStyle);
             sLayout.bind("layout", &sStyle);
             sPolicy.bind("policy", &sStyle);
+            sFrameRate.bind("frame.rate", &sStyle);
 
             // Cache the actual scaling factor
             fScaling    = sScaling.get();
@@ -155,10 +167,6 @@ namespace lsp
             // Set self event handler
             pWindow->set_handler(this);
 
-            // Bind redraw handler
-            sRedraw.bind(dpy);
-            sRedraw.set_handler(tmr_redraw_request, self());
-
             lsp_trace("Window has been initialized");
 
             if (sVisibility.get())
@@ -235,6 +243,11 @@ namespace lsp
 
         void Window::do_destroy()
         {
+            pDisplay->cancel_redraw(this);
+            drop_motion();
+            vDamage.flush();
+            vRelayout.flush();
+
             if (pChild != NULL)
             {
                 unlink_widget(pChild);
@@ -256,15 +269,6 @@ namespace lsp
             WidgetContainer::destroy();
         }
 
-        status_t Window::tmr_redraw_request(ws::timestamp_t sched, ws::timestamp_t ts, void *args)
-        {
-            if (args == NULL)
-                return STATUS_BAD_ARGUMENTS;
-
-            Window *_this   = widget_ptrcast<Window>(args);
-            return (_this != NULL) ? _this->do_render() : STATUS_BAD_ARGUMENTS;
-        }
-
         status_t Window::slot_window_close(Widget *sender, void *ptr, void *data)
         {
             if ((ptr == NULL) || (data == NULL))
@@ -281,6 +285,7 @@ namespace lsp
 
             if (resize_pending())
                 sync_size();
+            relayout_widgets();
 
             if (!redraw_pending())
                 return STATUS_OK;
@@ -292,20 +297,50 @@ namespace lsp
 
             size_t flags = nFlags;
 
+            // The back surface is going to be re-created, all previous contents will be lost
+            if ((pSurface == NULL) ||
+                (ssize_t(pSurface->width()) != sSize.nWidth) ||
+                (ssize_t(pSurface->height()) != sSize.nHeight))
+                bFullDamage     = true;
+
             ws::ISurface *bs = get_surface(s);
+            if (bs == NULL)
+                return STATUS_OK;
+
+            // Fetch the list of damaged regions, widgets may damage the window again while rendering
+            ws::rectangle_t damage[MAX_DAMAGE_REGIONS];
+            size_t ndamage  = lsp_min(vDamage.size(), size_t(MAX_DAMAGE_REGIONS));
+            if ((bFullDamage) || (ndamage <= 0))
+            {
+                Size::init(&damage[0], 0, 0, sSize.nWidth, sSize.nHeight);
+                ndamage         = 1;
+            }
+            else
+            {
+                for (size_t i=0; i<ndamage; ++i)
+                    damage[i]       = *vDamage.uget(i);
+            }
+            vDamage.clear();
+            bFullDamage     = false;
+
+            // Render only damaged regions
             bs->begin();
+            for (size_t i=0; i<ndamage; ++i)
             {
-                ws::rectangle_t xr;
-                xr.nLeft    = 0;
-                xr.nTop     = 0;
-                xr.nWidth   = sSize.nWidth;
-                xr.nHeight  = sSize.nHeight;
-                render(bs, &xr, flags);
+                bs->clip_begin(&damage[i]);
+                    render(bs, &damage[i], flags);
+                bs->clip_end();
             }
             bs->end();
 
+            // Copy only damaged regions to the window
             s->begin();
-                s->draw(bs, 0, 0);
+            for (size_t i=0; i<ndamage; ++i)
+            {
+                s->clip_begin(&damage[i]);
+                    s->draw(bs, 0, 0);
+                s->clip_end();
+            }
             s->end();
             commit_redraw();
 
@@ -315,6 +350,30 @@ namespace lsp
             return STATUS_OK;
         }
 
+        void Window::render_frame(ws::timestamp_t time)
+        {
+            // Compute the time of the next frame before rendering: redraw requests issued
+            // while rendering are scheduled to the next frame. The next frame always comes
+            // after the current one, so the window is rendered at most once per pass
+            float fps               = sFrameRate.get();
+            ws::timestamp_t period  = (fps > 0.0f) ? lsp_max(1000.0f / fps, 1.0f) : 1;
+            nNextFrame              = time + period;
+
+            do_render();
+
+            // Rendering took more time than the frame period, skip frames that should
+            // have been rendered meanwhile to give time for processing other events
+            ws::timestamp_t now     = Display::current_time();
+            if (now >= nNextFrame)
+                nNextFrame              = time + ((now - time) / period + 1) * period;
+
+            // The window may remain dirty if it could not be rendered, for example when
+            // it has no surface yet. Child widgets do not query for redraw again while
+            // their flags are set, so retry at the next frame
+            if ((bMapped) && ((redraw_pending()) || (resize_pending())))
+                pDisplay->query_redraw(this);
+        }
+
         status_t Window::get_screen_rectangle(ws::rectangle_t *r)
         {
             if (pWindow == NULL)
@@ -685,6 +744,16 @@ namespace lsp
             status_t result = STATUS_OK;
             ws::event_t ev = *e;
 
+            // Merge mouse motion events while dragging, deliver the deferred
+            // motion event before any other event to keep the order of events
+            if (e->nType == ws::UIE_MOUSE_MOVE)
+            {
+                if (defer_motion(e))
+                    return STATUS_OK;
+            }
+            else
+                flush_motion();
+
             switch (e->nType)
             {
                 //-------------------------------------------------------------
@@ -694,7 +763,7 @@ namespace lsp
                     if (!bMapped)
                     {
                         bMapped     = true;
-                        sRedraw.launch(-1, 40);
+                        nNextFrame  = 0;
                         query_draw(REDRAW_SURFACE);
                     }
                     break;
@@ -704,13 +773,9 @@ namespace lsp
                     if (bMapped)
                     {
                         bMapped     = false;
-                        if (pSurface != NULL)
-                        {
-                            pSurface->destroy();
-                            delete pSurface;
-                            pSurface = NULL;
-                        }
-                        sRedraw.cancel();
+                        drop_surface(&pSurface);
+                        drop_motion();
+                        pDisplay->cancel_redraw(this);
                     }
                     break;
 
@@ -786,20 +851,8 @@ namespace lsp
                 }
 
                 case ws::UIE_MOUSE_MOVE:
-                {
-//                    lsp_trace("e->nCode = %d, e->nState=0x%x state = 0x%x",
-//                            int(e->nCode), int(e->nState), int(hMouse.nState));
-                    Widget *h       = acquire_mouse_handler(e);
-                    hMouse.nState   = e->nState;
-                    hMouse.nLeft    = e->nLeft;
-                    hMouse.nTop     = e->nTop;
-
-                    if (h == this)
-                        result          = WidgetContainer::handle_event(e);
-                    else if (h != NULL)
-                        result          = h->handle_event(e);
+                    result      = handle_motion(e);
                     break;
-                };
 
                 case ws::UIE_MOUSE_CLICK:
                 case ws::UIE_MOUSE_DBL_CLICK:
@@ -941,6 +994,95 @@ namespace lsp
             return result;
         }
 
+        status_t Window::handle_motion(const ws::event_t *e)
+        {
+//            lsp_trace("e->nCode = %d, e->nState=0x%x state = 0x%x",
+//                    int(e->nCode), int(e->nState), int(hMouse.nState));
+            Widget *h       = acquire_mouse_handler(e);
+            hMouse.nState   = e->nState;
+            hMouse.nLeft    = e->nLeft;
+            hMouse.nTop     = e->nTop;
+
+            if (h == this)
+                return WidgetContainer::handle_event(e);
+            else if (h != NULL)
+                return h->handle_event(e);
+
+            return STATUS_OK;
+        }
+
+        bool Window::defer_motion(const ws::event_t *e)
+        {
+            // Motion events can be merged only while the mouse handler is locked by
+            // pressed buttons, so the handler won't change until the button release
+            Widget *h       = hMouse.pWidget;
+            bool defer      = (h != NULL) && (h != this) &&
+                              (hMouse.nState & ws::MCF_BTN_MASK) &&
+                              (e->nState & ws::MCF_BTN_MASK) &&
+                              (h->motion_coalescing());
+
+            // Deliver the pending event if the new one can not replace it
+            if ((bMotion) && ((!defer) || (sMotion.nState != e->nState)))
+                flush_motion();
+            if (!defer)
+                return false;
+
+            // Make sure that the pending event will be delivered after
+            // all currently queued events have been processed
+            if (nMotionTask < 0)
+            {
+                ws::IDisplay *dpy   = pDisplay->display();
+                if (dpy == NULL)
+                    return false;
+                ws::taskid_t id     = dpy->submit_task(Display::current_time(), motion_task_handler, this);
+                if (id < 0)
+                    return false;
+                nMotionTask         = id;
+            }
+
+            // Keep the latest coordinates only: widgets compute the motion delta
+            // relative to the position of the button press
+            sMotion         = *e;
+            bMotion         = true;
+
+            return true;
+        }
+
+        status_t Window::flush_motion()
+        {
+            if (!bMotion)
+                return STATUS_OK;
+
+            ws::event_t ev  = sMotion;
+            bMotion         = false;
+
+            status_t res    = handle_motion(&ev);
+            update_pointer();
+            return res;
+        }
+
+        void Window::drop_motion()
+        {
+            bMotion         = false;
+            if (nMotionTask < 0)
+                return;
+
+            ws::IDisplay *dpy   = pDisplay->display();
+            if (dpy != NULL)
+                dpy->cancel_task(nMotionTask);
+            nMotionTask     = -1;
+        }
+
+        status_t Window::motion_task_handler(ws::timestamp_t sched, ws::timestamp_t time, void *arg)
+        {
+            Window *_this   = static_cast<Window *>(arg);
+            if (_this == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            _this->nMotionTask  = -1;
+            return _this->flush_motion();
+        }
+
         status_t Window::resize_window(const ws::rectangle_t *size)
         {
             sPosition.set(size->nLeft, size->nTop);
@@ -1119,11 +1261,63 @@ namespace lsp
             pChild->realize_widget(&rc);
         }
 
+        void Window::query_relayout(Widget *w)
+        {
+            if (vRelayout.index_of(w) < 0)
+            {
+                // Fall back to the relayout of the whole window on error
+                if (!vRelayout.add(w))
+                {
+                    query_resize();
+                    return;
+                }
+            }
+
+            // Wake up the redraw scheduler
+            if (bMapped)
+                pDisplay->query_redraw(this);
+        }
+
+        void Window::relayout_widgets()
+        {
+            // Widgets may be realized by the full relayout or may become hidden,
+            // the list also may grow while realizing widgets
+            for (size_t i=0; i<vRelayout.size(); ++i)
+            {
+                Widget *w   = vRelayout.uget(i);
+                if ((w->toplevel() != this) || (!w->resize_pending()) || (!w->visibility()->get()))
+                    continue;
+
+                ws::rectangle_t r;
+                w->get_rectangle(&r);
+                w->realize_widget(&r);
+            }
+
+            vRelayout.clear();
+        }
+
         void Window::discard_widget(Widget *w)
         {
             if (w == NULL)
                 return;
 
+            // Forget the widget and all it's children pending for relayout
+            for (size_t i=0; i<vRelayout.size(); )
+            {
+                Widget *rw  = vRelayout.uget(i);
+                while ((rw != NULL) && (rw != w))
+                    rw          = rw->parent();
+
+                if (rw != NULL)
+                    vRelayout.qremove(i);
+                else
+                    ++i;
+            }
+
+            // Drop the deferred motion event addressed to the widget
+            if ((bMotion) && (hMouse.pWidget == w))
+                bMotion         = false;
+
             // Kill focus on the widget
             kill_focus(w);
 
@@ -1145,6 +1339,81 @@ namespace lsp
             }
         }
 
+        void Window::query_damage(const ws::rectangle_t *r)
+        {
+            if (bFullDamage)
+                return;
+            else if (r == NULL)
+            {
+                vDamage.clear();
+                bFullDamage     = true;
+                return;
+            }
+
+            // Limit the damaged region with the window area
+            ws::rectangle_t xr, wr;
+            Size::init(&wr, 0, 0, sSize.nWidth, sSize.nHeight);
+            if (!Size::intersection(&xr, r, &wr))
+                return;
+
+            // Merge the region with all damaged regions it overlaps
+            for (size_t i=0; i<vDamage.size(); )
+            {
+                ws::rectangle_t *dr = vDamage.uget(i);
+                if (Size::inside(dr, &xr))
+                    return;
+                if (!Size::overlap(dr, &xr))
+                {
+                    ++i;
+                    continue;
+                }
+
+                // The extended region may now overlap regions that have been already checked
+                Size::bounds(&xr, dr);
+                vDamage.remove(i);
+                i   = 0;
+            }
+
+            // Collapse all regions into one if there are too many of them
+            if (vDamage.size() >= MAX_DAMAGE_REGIONS)
+            {
+                for (size_t i=0, n=vDamage.size(); i<n; ++i)
+                    Size::bounds(&xr, vDamage.uget(i));
+                vDamage.clear();
+            }
+
+            // Check that the whole window is damaged
+            if (Size::inside(&xr, &wr))
+            {
+                vDamage.clear();
+                bFullDamage     = true;
+                return;
+            }
+
+            if (!vDamage.add(&xr))
+                bFullDamage     = true;
+        }
+
+        void Window::query_draw(size_t flags)
+        {
+            if ((flags & REDRAW_SURFACE) && (sVisibility.get()))
+                query_damage(NULL);
+            WidgetContainer::query_draw(flags);
+
+            // Wake up the redraw scheduler
+            if ((bMapped) && (redraw_pending()))
+                pDisplay->query_redraw(this);
+        }
+
+        void Window::query_resize()
+        {
+            WidgetContainer::query_resize();
+
+            // Wake up the redraw scheduler
+            if ((bMapped) && (resize_pending()))
+                pDisplay->query_redraw(this);
+        }
+
         void Window::size_request(ws::size_limit_t *r)
         {
             float scaling       = lsp_max(0.0f, sScaling.get());
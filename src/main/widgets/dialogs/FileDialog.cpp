@@ -393,6 +393,7 @@ namespace lsp
             pWConfirm       = NULL;
             pWSearch        = NULL;
             pWMessage       = NULL;
+            pScan           = NULL;
 
             pSelBookmark    = NULL;
             pPopupBookmark  = NULL;
@@ -415,7 +416,13 @@ namespace lsp
             nFlags     |= FINALIZED;
             Window::destroy();
 
+            // Stop all directory scans
+            sScanTimer.cancel();
+            cancel_scan();
+            reap_scans(true);
+
             drop_bookmarks();
+            sFileModel.clear();
             destroy_file_entries(&vFiles);
 
             // Clear dynamically allocated widgets
@@ -510,6 +517,10 @@ namespace lsp
 
             lsp_trace("Scaling factor: %f", sScaling.get());
 
+            // Init timer
+            sScanTimer.bind(pDisplay);
+            sScanTimer.set_handler(scan_timer_handler, self());
+
             // Init styles
             pBMNormal       = pDisplay->schema()->get("FileDialog::Bookmark");
             if (pBMNormal == NULL)
@@ -535,6 +546,7 @@ namespace lsp
             LSP_STATUS_ASSERT(inject_style(&sWFilter, "FileDialog::FilterComboBox"));
 
             LSP_STATUS_ASSERT(sWFiles.init());
+            sWFiles.set_model(&sFileModel);
             LSP_STATUS_ASSERT(inject_style(&sWFiles, "FileDialog::FileList"));
 
             LSP_STATUS_ASSERT(sWAction.init());
@@ -1258,7 +1270,6 @@ namespace lsp
             if (!sVisibility.get())
                 return STATUS_OK;
 
-            sWFiles.selected()->clear();
             return apply_filters();
         }
 
@@ -1386,7 +1397,8 @@ namespace lsp
             if (pWConfirm != NULL)
                 pWConfirm->hide();
             hide();
-            destroy_file_entries(&vFiles);
+            cancel_scan();
+            drop_file_entries();
             drop_bookmarks();
 
             // Execute slots
@@ -1400,7 +1412,8 @@ namespace lsp
                 pWConfirm->hide();
             drop_bookmarks();
             hide();
-            destroy_file_entries(&vFiles);
+            cancel_scan();
+            drop_file_entries();
 
             // Execute slots
             return sSlots.execute(SLOT_CANCEL, this, data);
@@ -1867,10 +1880,14 @@ namespace lsp
 
         status_t FileDialog::refresh_current_path()
         {
-            lltl::parray<f_entry_t> scanned;
-            LSPString str, path;
+            LSPString path;
             status_t xres;
 
+            // Stop reading the previous directory and drop its contents
+            cancel_scan();
+            drop_file_entries();
+            sWWarning.hide();
+
             // Obtain the path to working directory
             io::Path xpath;
             xres = sPath.format(&path);
@@ -1886,37 +1903,147 @@ namespace lsp
                 }
             }
             if ((xres == STATUS_OK) && (!xpath.is_root())) // Need to add dotdot entry?
-                xres = add_file_entry(&scanned, "..", F_DOTDOT);
+                xres = add_file_entry(&vFiles, "..", F_DOTDOT);
+
+            // Start reading the directory in background, the contents will be
+            // added to the list progressively by the scan timer
+            if (xres == STATUS_OK)
+                xres = start_scan(&xpath);
 
             if (xres != STATUS_OK) // Check result
             {
-                destroy_file_entries(&scanned);
+                drop_file_entries();
+                apply_filters();
                 return xres;
             }
 
-            // Open directory for reading
-            io::Dir dir;
-            xres = dir.open(&xpath);
-            if (xres == STATUS_OK)
+            apply_filters();
+
+            return select_current_bookmark();
+        }
+
+        status_t FileDialog::start_scan(const io::Path *path)
+        {
+            scan_t *scan        = new scan_t();
+            if (scan == NULL)
+                return STATUS_NO_MEM;
+
+            scan->pThread       = NULL;
+            scan->nResult       = STATUS_OK;
+            scan->bDone         = false;
+            scan->bCancel       = false;
+
+            status_t res        = scan->sPath.set(path);
+            if (res == STATUS_OK)
+            {
+                scan->pThread       = new ipc::Thread(scan_directory, scan);
+                if (scan->pThread == NULL)
+                    res                 = STATUS_NO_MEM;
+            }
+            if (res == STATUS_OK)
+                res                 = scan->pThread->start();
+            if (res != STATUS_OK)
             {
-                sWWarning.hide();
+                destroy_scan(scan);
+                return res;
+            }
+
+            pScan               = scan;
+
+            return sScanTimer.launch(0, SCAN_POLL_PERIOD);
+        }
+
+        void FileDialog::cancel_scan()
+        {
+            if (pScan == NULL)
+                return;
+
+            // Do not wait for the worker: it can be blocked by slow I/O. The scan
+            // will be destroyed by the scan timer after the worker terminates
+            pScan->bCancel      = true;
+            if (!vScans.add(pScan))
+                destroy_scan(pScan);
+            pScan               = NULL;
+        }
 
-                // Read directory
-                io::fattr_t fattr;
-                io::Path fname;
+        void FileDialog::reap_scans(bool wait)
+        {
+            for (size_t i=0; i<vScans.size(); )
+            {
+                scan_t *scan    = vScans.uget(i);
+                bool done       = wait;
+                if (!done)
+                {
+                    scan->sLock.lock();
+                    done            = scan->bDone;
+                    scan->sLock.unlock();
+                }
 
-                while (dir.reads(&fname, &fattr, false) == STATUS_OK)
+                if (done)
                 {
-                    // Reject dot and dotdot from search
-                    if ((fname.is_dot()) || (fname.is_dotdot()))
-                        continue;
+                    vScans.remove(i);
+                    destroy_scan(scan);
+                }
+                else
+                    ++i;
+            }
+        }
 
-                    // Analyze file flags
-                    size_t nflags = 0;
-                    if (fname.as_string()->first() == '.')
-                        nflags      |= F_ISHIDDEN;
+        void FileDialog::destroy_scan(scan_t *scan)
+        {
+            if (scan->pThread != NULL)
+            {
+                scan->pThread->join();
+                delete scan->pThread;
+                scan->pThread       = NULL;
+            }
 
-                    if (fattr.type == io::fattr_t::FT_DIRECTORY) // Directory?
+            destroy_file_entries(&scan->vBatch);
+            delete scan;
+        }
+
+        status_t FileDialog::scan_directory(void *arg)
+        {
+            scan_t *scan = static_cast<scan_t *>(arg);
+            lltl::parray<f_entry_t> scanned;
+            io::fattr_t fattr;
+            io::Path fname;
+            io::Dir dir;
+
+            // Open directory for reading
+            status_t xres = dir.open(&scan->sPath);
+            if (xres != STATUS_OK)
+                return pass_scanned_entries(scan, &scanned, true, xres);
+
+            // Read directory
+            while ((!scan->bCancel) && (dir.reads(&fname, &fattr, false) == STATUS_OK))
+            {
+                // Reject dot and dotdot from search
+                if ((fname.is_dot()) || (fname.is_dotdot()))
+                    continue;
+
+                // Analyze file flags
+                size_t nflags = 0;
+                if (fname.as_string()->first() == '.')
+                    nflags      |= F_ISHIDDEN;
+
+                if (fattr.type == io::fattr_t::FT_DIRECTORY) // Directory?
+                    nflags      |= F_ISDIR;
+                else if (fattr.type == io::fattr_t::FT_SYMLINK) // Symbolic link?
+                    nflags      |= F_ISLINK;
+                else if (fattr.type == io::fattr_t::FT_REGULAR)
+                    nflags      |= F_ISREG;
+                else
+                    nflags      |= F_ISOTHER;
+
+                if (nflags & F_ISLINK)
+                {
+                    // Stat a file associated with symbolic link
+                    xres = dir.sym_stat(&fname, &fattr);
+
+                    if (xres != STATUS_OK)
+                        nflags      |= F_ISINVALID;
+                    else if (fattr.type == io::fattr_t::FT_DIRECTORY) // Directory?
                         nflags      |= F_ISDIR;
                     else if (fattr.type == io::fattr_t::FT_SYMLINK) // Symbolic link?
                         nflags      |= F_ISLINK;
@@ -1924,68 +2051,161 @@ namespace lsp
                         nflags      |= F_ISREG;
                     else
                         nflags      |= F_ISOTHER;
+                }
 
-                    if (nflags & F_ISLINK)
-                    {
-                        // Stat a file associated with symbolic link
-                        xres = dir.sym_stat(&fname, &fattr);
-
-                        if (xres != STATUS_OK)
-                            nflags      |= F_ISINVALID;
-                        else if (fattr.type == io::fattr_t::FT_DIRECTORY) // Directory?
-                            nflags      |= F_ISDIR;
-                        else if (fattr.type == io::fattr_t::FT_SYMLINK) // Symbolic link?
-                            nflags      |= F_ISLINK;
-                        else if (fattr.type == io::fattr_t::FT_REGULAR)
-                            nflags      |= F_ISREG;
-                        else
-                            nflags      |= F_ISOTHER;
-                    }
+                // Add entry to list of found files
+                if ((xres = add_file_entry(&scanned, fname.as_native(), nflags)) != STATUS_OK)
+                {
+                    dir.close();
+                    return pass_scanned_entries(scan, &scanned, true, xres);
+                }
 
-                    // Add entry to list of found files
-                    if ((xres = add_file_entry(&scanned, fname.as_native(), nflags)) != STATUS_OK)
+                // Pass the batch of entries to the UI
+                if (scanned.size() >= SCAN_BATCH_SIZE)
+                {
+                    if ((xres = pass_scanned_entries(scan, &scanned, false, STATUS_OK)) != STATUS_OK)
                     {
                         dir.close();
-                        destroy_file_entries(&scanned);
-                        return xres;
+                        return pass_scanned_entries(scan, &scanned, true, xres);
                     }
                 }
+            }
 
-                // Close directory
-                if (dir.close() != STATUS_OK)
-                {
-                    destroy_file_entries(&scanned);
-                    return STATUS_IO_ERROR;
-                }
+            // Close directory
+            xres = (dir.close() != STATUS_OK) ? STATUS_IO_ERROR : STATUS_OK;
+            return pass_scanned_entries(scan, &scanned, true, xres);
+        }
+
+        status_t FileDialog::pass_scanned_entries(scan_t *scan, lltl::parray<f_entry_t> *list, bool done, status_t result)
+        {
+            status_t res = STATUS_OK;
+
+            scan->sLock.lock();
+            for (size_t i=0, n=list->size(); i<n; ++i)
+            {
+                f_entry_t *ent = list->uget(i);
+                if ((res == STATUS_OK) && (scan->vBatch.add(ent)))
+                    continue;
+                res     = STATUS_NO_MEM;
+                delete ent;
             }
-            else // Analyze errcode
+            list->clear();
+
+            if (done)
             {
-                const char *text = "unknown I/O error";
-                switch (xres)
+                scan->nResult   = result;
+                scan->bDone     = true;
+            }
+            scan->sLock.unlock();
+
+            return (done) ? result : res;
+        }
+
+        status_t FileDialog::scan_timer_handler(ws::timestamp_t sched, ws::timestamp_t time, void *arg)
+        {
+            FileDialog *_this = widget_ptrcast<FileDialog>(arg);
+            if (_this == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            _this->reap_scans(false);
+            status_t res = _this->fetch_scanned_entries();
+
+            // Stop polling when there are no more scans
+            if ((_this->pScan == NULL) && (_this->vScans.size() <= 0))
+                _this->sScanTimer.cancel();
+
+            return res;
+        }
+
+        status_t FileDialog::fetch_scanned_entries()
+        {
+            if (pScan == NULL)
+                return STATUS_OK;
+
+            // Take the entries scanned since the last call
+            lltl::parray<f_entry_t> scanned;
+            pScan->sLock.lock();
+            scanned.swap(&pScan->vBatch);
+            bool done           = pScan->bDone;
+            status_t result     = pScan->nResult;
+            pScan->sLock.unlock();
+
+            status_t res        = STATUS_OK;
+            if (scanned.size() > 0)
+            {
+                // Merge the entries and update the list, keep the selection
+                f_entry_t *sel      = selected_entry();
+                res                 = merge_file_entries(&scanned);
+                destroy_file_entries(&scanned);
+
+                if (res == STATUS_OK)
+                    res                 = apply_filters();
+                if ((res == STATUS_OK) && (sel != NULL) && (sFileModel.vSelected.is_empty()))
                 {
-                    case STATUS_PERMISSION_DENIED:    text = "permission denied"; break;
-                    case STATUS_NOT_FOUND:    text = "directory does not exist"; break;
-                    case STATUS_NO_MEM:    text = "not enough memory"; break;
-                    default: break;
+                    ssize_t index = sFileModel.vRows.index_of(sel);
+                    if (index >= 0)
+                        sFileModel.select(index, true);
                 }
+            }
+
+            if (done)
+            {
+                destroy_scan(pScan);
+                pScan               = NULL;
+                if (result != STATUS_OK)
+                    show_scan_error(result);
+            }
 
-                str.set_native("Access error: ");
-                path.set_native(text);
-                str.append(&path);
-                sWWarning.text()->set_raw(&str);
-                sWWarning.show();
+            return res;
+        }
+
+        void FileDialog::show_scan_error(status_t code)
+        {
+            LSPString str, tmp;
+            const char *text = "unknown I/O error";
+            switch (code)
+            {
+                case STATUS_PERMISSION_DENIED:    text = "permission denied"; break;
+                case STATUS_NOT_FOUND:    text = "directory does not exist"; break;
+                case STATUS_NO_MEM:    text = "not enough memory"; break;
+                default: break;
             }
 
-            // Now we have the complete list of files, need to reorder them
-            scanned.qsort(cmp_file_entry);
+            str.set_native("Access error: ");
+            tmp.set_native(text);
+            str.append(&tmp);
+            sWWarning.text()->set_raw(&str);
+            sWWarning.show();
+        }
 
-            // Alright, now we can swap contents and delete previous contents
-            vFiles.swap(&scanned);
-            destroy_file_entries(&scanned);
+        status_t FileDialog::merge_file_entries(lltl::parray<f_entry_t> *list)
+        {
+            lltl::parray<f_entry_t> merged;
+            list->qsort(cmp_file_entry);
 
-            apply_filters();
+            // Both lists are sorted, merge them
+            size_t i=0, j=0, n=vFiles.size(), m=list->size();
+            while ((i < n) || (j < m))
+            {
+                f_entry_t *ent;
+                if (j >= m)
+                    ent     = vFiles.uget(i++);
+                else if (i >= n)
+                    ent     = list->uget(j++);
+                else if (cmp_file_entry(vFiles.uget(i), list->uget(j)) <= 0)
+                    ent     = vFiles.uget(i++);
+                else
+                    ent     = list->uget(j++);
+
+                if (!merged.add(ent))
+                    return STATUS_NO_MEM;
+            }
 
-            return select_current_bookmark();
+            // All entries are now owned by the merged list
+            vFiles.swap(&merged);
+            list->clear();
+
+            return STATUS_OK;
         }
 
         ssize_t FileDialog::cmp_file_entry(const f_entry_t *a, const f_entry_t *b)
@@ -2030,13 +2250,14 @@ namespace lsp
 
         FileDialog::f_entry_t *FileDialog::selected_entry()
         {
-            ListBoxItem *item = sWFiles.selected()->any();
-            if (item == NULL)
-                return NULL;
-            ssize_t index = item->tag()->get();
-            if (index < 0)
-                return NULL;
-            return vFiles.get(index);
+            return sFileModel.vSelected.last();
+        }
+
+        void FileDialog::drop_file_entries()
+        {
+            sFileModel.clear();
+            sWFiles.update_model();
+            destroy_file_entries(&vFiles);
         }
 
         status_t FileDialog::sync_filters()
@@ -2097,10 +2318,7 @@ namespace lsp
                 }
             }
             else
-            {
-                sWFiles.selected()->clear();
                 LSP_STATUS_ASSERT(sWSearch.text()->format(&xfname));
-            }
 
             if (sWFilter.items()->size() > 0)
             {
@@ -2109,10 +2327,9 @@ namespace lsp
                 fmask            = (tag >= 0) ? sFilter.get(tag) : NULL;
             }
 
-            // Now we need to fill data
-            WidgetList<ListBoxItem> *lst = sWFiles.items();
-            lst->clear();
-            float xs = sWFiles.hscroll()->get(), ys = sWFiles.vscroll()->get(); // Remember scroll values
+            // Now we need to fill data. The list box requests only visible rows
+            // from the model, so there is no need to create widgets for entries
+            sFileModel.clear();
 
             // Process files
             for (size_t i=0, n=vFiles.size(); i<n; ++i)
@@ -2130,44 +2347,14 @@ namespace lsp
                         continue;
                 }
 
-                // Add some special characters
-                if (ent->nFlags & (F_ISOTHER | F_ISDIR | F_ISLINK | F_ISINVALID))
+                // Add row
+                ssize_t row = sFileModel.vRows.size();
+                if (!sFileModel.vRows.add(ent))
                 {
-                    if (!tmp.set(psrc))
-                    {
-                        lst->clear();
-                        return STATUS_NO_MEM;
-                    }
-                    psrc = &tmp;
-
-                    // Modify the name of the item
-                    bool ok = true;
-                    if (ent->nFlags & F_ISOTHER)
-                        ok = ok && psrc->prepend('*');
-                    else if (ent->nFlags & (F_ISLINK | F_ISINVALID))
-                        ok = ok && psrc->prepend((ent->nFlags & F_ISINVALID) ? '!' : '~');
-
-                    if (ent->nFlags & F_ISDIR)
-                    {
-                        ok = ok && psrc->prepend('[');
-                        ok = ok && psrc->append(']');
-                    }
-
-                    if (!ok)
-                    {
-                        lst->clear();
-                        return STATUS_NO_MEM;
-                    }
-                }
-
-                // Add item
-                ListBoxItem *item = new ListBoxItem(pDisplay);
-                if (item == NULL)
+                    sFileModel.clear();
+                    sWFiles.update_model();
                     return STATUS_NO_MEM;
-                LSP_STATUS_ASSERT(item->init());
-                item->text()->set_raw(psrc);
-                item->tag()->set(i);
-                LSP_STATUS_ASSERT(lst->madd(item));
+                }
 
                 // Check if is equal
                 if ((!(ent->nFlags & (F_ISDIR | F_DOTDOT))) && (xfname.length() > 0))
@@ -2175,21 +2362,96 @@ namespace lsp
 //                    lsp_trace("  %s <-> %s", ent->sName.get_native(), xfname.get_native());
                     #ifdef PLATFORM_WINDOWS
                     if (ent->sName.equals_nocase(&xfname))
-                        sWFiles.selected()->add(item);
+                        sFileModel.select(row, true);
                     #else
                     if (ent->sName.equals(&xfname))
-                        sWFiles.selected()->add(item);
+                        sFileModel.select(row, true);
                     #endif /* PLATFORM_WINDOWS */
                 }
             }
 
-            // Restore scroll values
-            sWFiles.hscroll()->set(xs);
-            sWFiles.vscroll()->set(ys);
+            sWFiles.update_model();
 
             return STATUS_OK;
         }
 
+        FileDialog::FileListModel::~FileListModel()
+        {
+            // Entries are owned by the dialog
+            vRows.flush();
+            vSelected.flush();
+        }
+
+        size_t FileDialog::FileListModel::rows()
+        {
+            return vRows.size();
+        }
+
+        status_t FileDialog::FileListModel::format(LSPString *dst, size_t row)
+        {
+            f_entry_t *ent = vRows.get(row);
+            if (ent == NULL)
+                return STATUS_NOT_FOUND;
+            if (!dst->set(&ent->sName))
+                return STATUS_NO_MEM;
+
+            // Add some special characters
+            bool ok = true;
+            if (ent->nFlags & F_ISOTHER)
+                ok = ok && dst->prepend('*');
+            else if (ent->nFlags & (F_ISLINK | F_ISINVALID))
+                ok = ok && dst->prepend((ent->nFlags & F_ISINVALID) ? '!' : '~');
+
+            if (ent->nFlags & F_ISDIR)
+            {
+                ok = ok && dst->prepend('[');
+                ok = ok && dst->append(']');
+            }
+
+            return (ok) ? STATUS_OK : STATUS_NO_MEM;
+        }
+
+        bool FileDialog::FileListModel::selected(size_t row)
+        {
+            f_entry_t *ent = vRows.get(row);
+            return (ent != NULL) && (ent->nFlags & F_SELECTED);
+        }
+
+        void FileDialog::FileListModel::select(size_t row, bool selected)
+        {
+            f_entry_t *ent = vRows.get(row);
+            if ((ent == NULL) || (bool(ent->nFlags & F_SELECTED) == selected))
+                return;
+
+            if (selected)
+            {
+                if (!vSelected.add(ent))
+                    return;
+                ent->nFlags    |= F_SELECTED;
+            }
+            else
+            {
+                vSelected.premove(ent);
+                ent->nFlags    &= ~F_SELECTED;
+            }
+        }
+
+        void FileDialog::FileListModel::unselect_all()
+        {
+            for (size_t i=0, n=vSelected.size(); i<n; ++i)
+            {
+                f_entry_t *ent  = vSelected.uget(i);
+                ent->nFlags    &= ~F_SELECTED;
+            }
+            vSelected.clear();
+        }
+
+        void FileDialog::FileListModel::clear()
+        {
+            unselect_all();
+            vRows.clear();
+        }
+
         status_t FileDialog::show_message(const char *title, const char *heading, const char *message, const io::Path *path)
         {
             if (pWMessage == NULL)
@@ -73,6 +73,12 @@ namespace lsp
             sIPadding(&sProperties)
         {
             pGlass              = NULL;
+            for (size_t i=0; i<GLR_TOTAL; ++i)
+                vLayers[i]          = NULL;
+            nLayers             = (1 << GLR_TOTAL) - 1;
+            nHitCols            = 0;
+            nHitRows            = 0;
+            bHitIndex           = false;
 
             sCanvas.nLeft       = 0;
             sCanvas.nTop        = 0;
@@ -111,23 +117,134 @@ namespace lsp
                 unlink_widget(item);
             }
 
-            // Destroy glass
+            // Destroy glass and layers
             drop_glass();
+            drop_layers();
 
             vItems.flush();
             vAxis.flush();
             vBasis.flush();
             vOrigins.flush();
+
+            vHitBins.flush();
+            vHitItems.flush();
+            vHitAny.flush();
+            bHitIndex           = false;
         }
 
         void Graph::drop_glass()
         {
-            if (pGlass != NULL)
+            drop_surface(&pGlass);
+        }
+
+        void Graph::drop_layers()
+        {
+            for (size_t i=0; i<GLR_TOTAL; ++i)
+                drop_surface(&vLayers[i]);
+            nLayers             = (1 << GLR_TOTAL) - 1;
+        }
+
+        void Graph::drop_hit_index()
+        {
+            vHitBins.clear();
+            vHitItems.clear();
+            vHitAny.clear();
+            nHitCols            = 0;
+            nHitRows            = 0;
+            bHitIndex           = false;
+        }
+
+        bool Graph::build_hit_index()
+        {
+            drop_hit_index();
+
+            // Compute the number of bins
+            ssize_t left        = canvas_aleft();
+            ssize_t top         = canvas_atop();
+            size_t cols         = lsp_max(1, (sICanvas.nWidth  + HIT_BIN_SIZE) / HIT_BIN_SIZE);
+            size_t rows         = lsp_max(1, (sICanvas.nHeight + HIT_BIN_SIZE) / HIT_BIN_SIZE);
+
+            // Compute the range of bins covered by each item
+            ws::rectangle_t r;
+            lltl::darray<hit_range_t> ranges;
+
+            for (size_t i=0, n=vItems.size(); i<n; ++i)
+            {
+                GraphItem *gi = vItems.get(i);
+                if ((gi == NULL) || (!gi->is_visible_child_of(this)))
+                    continue;
+
+                // Item should be tested at any position?
+                if (!gi->hit_area(&r))
+                {
+                    size_t *index   = vHitAny.add();
+                    if (index == NULL)
+                        return false;
+                    *index          = i;
+                    continue;
+                }
+
+                // Clip the area with the canvas
+                ssize_t x0      = lsp_max(r.nLeft - left, 0);
+                ssize_t y0      = lsp_max(r.nTop  - top,  0);
+                ssize_t x1      = lsp_min(r.nLeft + r.nWidth  - left, sICanvas.nWidth  + 1);
+                ssize_t y1      = lsp_min(r.nTop  + r.nHeight - top,  sICanvas.nHeight + 1);
+                if ((x0 >= x1) || (y0 >= y1))
+                    continue;
+
+                hit_range_t *hr = ranges.add();
+                if (hr == NULL)
+                    return false;
+
+                hr->nIndex      = i;
+                hr->nFirstCol   = x0 / HIT_BIN_SIZE;
+                hr->nLastCol    = lsp_min(size_t((x1 - 1) / HIT_BIN_SIZE), cols - 1);
+                hr->nFirstRow   = y0 / HIT_BIN_SIZE;
+                hr->nLastRow    = lsp_min(size_t((y1 - 1) / HIT_BIN_SIZE), rows - 1);
+            }
+
+            // Count number of items in each bin, bin offsets are shifted by one element
+            size_t *bins        = vHitBins.add_n(cols * rows + 1);
+            if (bins == NULL)
+                return false;
+            for (size_t i=0, n=cols*rows + 1; i<n; ++i)
+                bins[i]             = 0;
+
+            for (size_t i=0, n=ranges.size(); i<n; ++i)
+            {
+                hit_range_t *hr = ranges.uget(i);
+                for (size_t y=hr->nFirstRow; y <= hr->nLastRow; ++y)
+                    for (size_t x=hr->nFirstCol; x <= hr->nLastCol; ++x)
+                        ++bins[y * cols + x + 1];
+            }
+
+            // Compute offsets of bins
+            for (size_t i=1, n=cols*rows + 1; i<n; ++i)
+                bins[i]            += bins[i-1];
+
+            // Fill bins with indices of items, the order of items in each bin is preserved
+            size_t *items       = vHitItems.add_n(bins[cols * rows]);
+            if ((items == NULL) && (bins[cols * rows] > 0))
+                return false;
+
+            for (size_t i=0, n=ranges.size(); i<n; ++i)
             {
-                pGlass->destroy();
-                delete pGlass;
-                pGlass = NULL;
+                hit_range_t *hr = ranges.uget(i);
+                for (size_t y=hr->nFirstRow; y <= hr->nLastRow; ++y)
+                    for (size_t x=hr->nFirstCol; x <= hr->nLastCol; ++x)
+                        items[bins[y * cols + x]++] = hr->nIndex;
             }
+
+            // Restore offsets of bins
+            for (size_t i=cols*rows; i > 0; --i)
+                bins[i]             = bins[i-1];
+            bins[0]             = 0;
+
+            nHitCols            = cols;
+            nHitRows            = rows;
+            bHitIndex           = true;
+
+            return true;
         }
 
         status_t Graph::init()
@@ -214,6 +331,7 @@ namespace lsp
         {
             // Call parent class to realize
             WidgetContainer::realize(r);
+            bHitIndex       = false;
 
             // Compute the size of area
             float scaling   = lsp_max(0.0f, sScaling.get());
@@ -252,6 +370,7 @@ namespace lsp
         {
             WidgetContainer::hide_widget();
             drop_glass();
+            drop_layers();
         }
 
         void Graph::render(ws::ISurface *s, const ws::rectangle_t *area, bool force)
@@ -266,11 +385,10 @@ namespace lsp
 
             // Prepare palette
             ws::ISurface *cv;
-            lsp::Color color(sColor);
+            lsp::Color color(sColor.bright_color(bright));
             lsp::Color bg_color;
 
             get_actual_bg_color(bg_color);
-            color.scale_lch_luminance(bright);
 
             s->clip_begin(area);
             {
@@ -286,16 +404,14 @@ namespace lsp
                     s->draw(cv, sCanvas.nLeft, sCanvas.nTop);
 
                 // Draw the glass and the border
-                color.copy(sGlassColor);
-                bg_color.copy(sBorderColor);
-                color.scale_lch_luminance(bright);
-                bg_color.scale_lch_luminance(bright);
+                color.copy(sGlassColor.bright_color(bright));
+                bg_color.copy(sBorderColor.bright_color(bright));
 
                 bool flat = sBorderFlat.get();
 
                 if (sGlass.get())
                 {
-                    cv = create_border_glass(&pGlass, s,
+                    cv = create_border_glass(pDisplay->surface_pool(), &pGlass, s,
                             color, bg_color,
                             SURFMASK_ALL_CORNER, bw, xr,
                             sSize.nWidth, sSize.nHeight, flat
@@ -315,27 +431,110 @@ namespace lsp
             s->clip_end();
         }
 
-        void Graph::draw(ws::ISurface *s)
+        void Graph::query_draw(size_t flags)
         {
-            // Clear canvas
-            lsp::Color c(sColor);
-            // c.set_rgb24(0x888888);
-            c.scale_lch_luminance(sBrightness.get());
-            s->clear(c);
+            // Redraw of the whole graph invalidates all layers and positions of items
+            if (flags & REDRAW_SURFACE)
+            {
+                nLayers             = (1 << GLR_TOTAL) - 1;
+                bHitIndex           = false;
+            }
+            WidgetContainer::query_draw(flags);
+        }
 
-            // Sync internal lists of axes and origins
-            sync_lists();
+        void Graph::query_draw_layer(size_t layer)
+        {
+            query_draw_layers(1 << layer);
+        }
 
-            // Draw all objects
-            for (size_t i=0, n=vItems.size(); i<n; ++i)
+        void Graph::query_draw_layers(size_t mask)
+        {
+            nLayers            |= mask & ((1 << GLR_TOTAL) - 1);
+
+            // Items of the data layer are not hit-tested by area, so their frequent updates
+            // should not drop the hit-test index. Markers and dots are hit-tested, and axes
+            // and origins of the static layer move them
+            if (mask & ((1 << GLR_STATIC) | (1 << GLR_MARKERS)))
+                bHitIndex           = false;
+            WidgetContainer::query_draw(REDRAW_SURFACE);
+        }
+
+        ws::ISurface *Graph::render_layer(ws::ISurface *s, size_t layer)
+        {
+            bool redraw     = nLayers & (1 << layer);
+            nLayers        &= ~(1 << layer);
+
+            // Check that the layer has visible items
+            size_t n        = vItems.size();
+            size_t first    = n;
+            for (size_t i=0; i<n; ++i)
+            {
+                GraphItem *gi = vItems.get(i);
+                if ((gi != NULL) && (gi->visibility()->get()) && (gi->layer() == layer))
+                {
+                    first       = i;
+                    break;
+                }
+            }
+            if (first >= n)
+            {
+                drop_surface(&vLayers[layer]);
+                return NULL;
+            }
+
+            // Check that the layer surface matches the size of the graph surface
+            ws::ISurface *ls    = vLayers[layer];
+            if ((ls != NULL) && ((ls->width() != s->width()) || (ls->height() != s->height())))
+                drop_surface(&vLayers[layer]);
+            if (vLayers[layer] == NULL)
+            {
+                vLayers[layer]      = pDisplay->surface_pool()->acquire(s, s->width(), s->height());
+                if (vLayers[layer] == NULL)
+                    return NULL;
+                redraw              = true;
+            }
+
+            ls                  = vLayers[layer];
+            if (!redraw)
+                return ls;
+
+            // Render all items of the layer
+            ls->begin();
+            ls->clear(lsp::Color(0.0f, 0.0f, 0.0f, 1.0f));
+
+            for (size_t i=first; i<n; ++i)
             {
                 GraphItem *gi = vItems.get(i);
-                if ((gi == NULL) || (!gi->visibility()->get()))
+                if ((gi == NULL) || (!gi->visibility()->get()) || (gi->layer() != layer))
                     continue;
 
-                gi->render(s, &sICanvas, true);
+                gi->render(ls, &sICanvas, true);
                 gi->commit_redraw();
             }
+
+            ls->end();
+
+            return ls;
+        }
+
+        void Graph::draw(ws::ISurface *s)
+        {
+            // Clear canvas
+            lsp::Color c(sColor.bright_color(sBrightness.get()));
+            s->clear(c);
+
+            // Sync internal lists of axes and origins: they may change only
+            // together with the layer containing axes and origins
+            if (nLayers & (1 << GLR_STATIC))
+                sync_lists();
+
+            // Render modified layers and compose all of them
+            for (size_t i=0; i<GLR_TOTAL; ++i)
+            {
+                ws::ISurface *ls = render_layer(s, i);
+                if (ls != NULL)
+                    s->draw(ls, 0, 0);
+            }
         }
 
         void Graph::sync_lists()
@@ -376,16 +575,49 @@ namespace lsp
             // Sync internal lists of axes and origins
             sync_lists();
 
-            // Lookup widgets
-            for (size_t i=0, n=vItems.size(); i<n; ++i)
+            // Rebuild the hit-test index if items have been changed
+            if ((!bHitIndex) && (!build_hit_index()))
             {
-                GraphItem *gi = vItems.get(i);
+                drop_hit_index();
+
+                // Lookup widgets
+                for (size_t i=0, n=vItems.size(); i<n; ++i)
+                {
+                    GraphItem *gi = vItems.get(i);
+                    if ((gi == NULL) || (!gi->is_visible_child_of(this)))
+                        continue;
+
+                    if (gi->inside(x, y))
+                        return gi;
+                }
+                return NULL;
+            }
+
+            // Get the bin and merge it's items with items that are tested at any
+            // position, keeping the original order of items
+            size_t col          = lsp_min(size_t(tx / HIT_BIN_SIZE), nHitCols - 1);
+            size_t row          = lsp_min(size_t(ty / HIT_BIN_SIZE), nHitRows - 1);
+            size_t bin          = row * nHitCols + col;
+            size_t first        = *vHitBins.uget(bin);
+            size_t last         = *vHitBins.uget(bin + 1);
+            size_t i            = 0, n = vHitAny.size();
+
+            while ((first < last) || (i < n))
+            {
+                size_t index;
+                if ((i >= n) || ((first < last) && (*vHitItems.uget(first) < *vHitAny.uget(i))))
+                    index           = *vHitItems.uget(first++);
+                else
+                    index           = *vHitAny.uget(i++);
+
+                GraphItem *gi = vItems.get(index);
                 if ((gi == NULL) || (!gi->is_visible_child_of(this)))
                     continue;
 
                 if (gi->inside(x, y))
                     return gi;
             }
+
             return NULL;
         }
 
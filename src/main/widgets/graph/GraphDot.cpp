@@ -251,6 +251,11 @@ namespace lsp
                 query_draw();
         }
 
+        graph_layer_t GraphDot::layer() const
+        {
+            return GLR_MARKERS;
+        }
+
         void GraphDot::render(ws::ISurface *s, const ws::rectangle_t *area, bool force)
         {
             // Get graph
@@ -348,7 +353,7 @@ namespace lsp
             return STATUS_OK;
         }
 
-        bool GraphDot::inside(ssize_t mx, ssize_t my)
+        bool GraphDot::get_hit_circle(float *cx, float *cy, float *cr)
         {
             if (!(nXFlags & F_EDITABLE))
                 return false;
@@ -386,13 +391,25 @@ namespace lsp
 
             float fdot      = (dot > 0) ? lsp_max(1.0f, dot * scaling) : 0.0f;
             float fpad      = ((border > 0) && (pad > 0)) ? lsp_max(1.0f, pad * scaling) : 0.0f;
-            float r    = lsp_max(2.0f, fdot + fpad);
+
+            *cx             = cv->canvas_aleft() + x;
+            *cy             = cv->canvas_atop()  + y;
+            *cr             = lsp_max(2.0f, fdot + fpad);
+
+            return true;
+        }
+
+        bool GraphDot::inside(ssize_t mx, ssize_t my)
+        {
+            float x, y, r;
+            if (!get_hit_circle(&x, &y, &r))
+                return false;
 
             // Update coordinates
 //            lsp_trace("mx = %d, my = %d", int(mx), int(my));
 
-            float dx        = mx - cv->canvas_aleft() - x;
-            float dy        = my - cv->canvas_atop()  - y;
+            float dx        = mx - x;
+            float dy        = my - y;
 
 //            lsp_trace("x = %f, y = %f", x, y);
 //            lsp_trace("dx = %f, dy = %f", dx, dy);
@@ -400,6 +417,20 @@ namespace lsp
             return dx*dx + dy*dy <= r*r;
         }
 
+        bool GraphDot::hit_area(ws::rectangle_t *r)
+        {
+            float x, y, cr;
+            if (!get_hit_circle(&x, &y, &cr))
+                return GraphItem::hit_area(r);
+
+            r->nLeft        = floorf(x - cr);
+            r->nTop         = floorf(y - cr);
+            r->nWidth       = ceilf(x + cr) - r->nLeft + 1;
+            r->nHeight      = ceilf(y + cr) - r->nTop + 1;
+
+            return true;
+        }
+
         void GraphDot::apply_motion(ssize_t x, ssize_t y, size_t flags)
         {
             // Get graph
@@ -73,10 +73,13 @@ namespace lsp
             bClear              = true;
             nRows               = 0;
             nCols               = 0;
+            nHead               = 0;
             pCalcColor          = &GraphFrameBuffer::calc_rainbow_color;
-            fRGBA               = NULL;
-            pfRGBA              = NULL;
-            nCapacity           = 0;
+            bSyncLUT            = true;
+            fLutMin             = 0.0f;
+            fLutMax             = 0.0f;
+            vLUT                = NULL;
+            pLUT                = NULL;
 
             pClass              = &metadata;
         }
@@ -96,12 +99,62 @@ namespace lsp
 
         void GraphFrameBuffer::destroy_data()
         {
-            if (pfRGBA != NULL)
-                lsp::free_aligned(pfRGBA);
+            if (pLUT != NULL)
+                lsp::free_aligned(pLUT);
 
-            fRGBA               = NULL;
-            pfRGBA              = NULL;
-            nCapacity           = 0;
+            vLUT                = NULL;
+            pLUT                = NULL;
+            bSyncLUT            = true;
+        }
+
+        bool GraphFrameBuffer::sync_lut()
+        {
+            float min       = lsp_min(sData.min(), sData.max());
+            float max       = lsp_max(sData.min(), sData.max());
+            if ((!bSyncLUT) && (vLUT != NULL) && (fLutMin == min) && (fLutMax == max))
+                return true;
+
+            // Allocate the lookup table
+            if (vLUT == NULL)
+            {
+                vLUT            = lsp::alloc_aligned<uint32_t>(pLUT, LUT_SIZE, 0x40);
+                if (vLUT == NULL)
+                    return false;
+            }
+
+            // Compute the colors for the whole range of values
+            float v[LUT_CHUNK];
+            float rgba[LUT_CHUNK * 4];
+            float k         = (max - min) / (LUT_SIZE - 1);
+
+            for (size_t off=0; off < LUT_SIZE; off += LUT_CHUNK)
+            {
+                for (size_t i=0; i<LUT_CHUNK; ++i)
+                    v[i]            = min + (off + i) * k;
+
+                (this->*pCalcColor)(rgba, v, LUT_CHUNK);
+                dsp::rgba_to_bgra32(&vLUT[off], rgba, LUT_CHUNK);
+            }
+
+            fLutMin         = min;
+            fLutMax         = max;
+            bSyncLUT        = false;
+
+            return true;
+        }
+
+        void GraphFrameBuffer::lut_to_bgra32(void *dst, const float *v, size_t n)
+        {
+            uint32_t *d     = static_cast<uint32_t *>(dst);
+            float delta     = fLutMax - fLutMin;
+            float k         = (delta > 0.0f) ? (LUT_SIZE - 1) / delta : 0.0f;
+
+            // Values are already limited by the frame data, the check is for safety only
+            for (size_t i=0; i<n; ++i)
+            {
+                ssize_t idx     = (v[i] - fLutMin) * k + 0.5f;
+                d[i]            = vLUT[lsp_limit(idx, 0, LUT_SIZE - 1)];
+            }
         }
 
         status_t GraphFrameBuffer::init()
@@ -158,6 +211,7 @@ namespace lsp
             if (sColor.is(prop))
             {
                 bClear      = true;
+                bSyncLUT    = true;
                 query_draw();
             }
             if (sFunction.is(prop))
@@ -177,6 +231,7 @@ namespace lsp
                 {
                     pCalcColor  = func;
                     bClear      = true;
+                    bSyncLUT    = true;
                     query_draw();
                 }
             }
@@ -185,44 +240,34 @@ namespace lsp
         void GraphFrameBuffer::draw(ws::ISurface *s)
         {
             // Need to deploy new changes?
-            size_t changes = (bClear) ? sData.rows() : sData.changes();
+            size_t changes = (bClear) ? nRows : lsp_min(size_t(sData.changes()), nRows);
             if (changes <= 0)
                 return;
 
-            // Allocate RGBA buffer
-            if (nCapacity != sData.stride())
-            {
-                uint8_t *ptr    = NULL;
-                float *rgba     = lsp::alloc_aligned<float>(ptr, sData.stride() * 4, 0x40); // 4 components per dot
-                if (rgba == NULL)
-                    return;
-                if (pfRGBA != NULL)
-                    lsp::free_aligned(pfRGBA);
-                fRGBA           = rgba;
-                pfRGBA          = ptr;
-                nCapacity       = sData.stride();
-            }
+            // Update the color lookup table
+            if (!sync_lut())
+                return;
 
             // Get target buffer for rendering
             uint8_t *xp     = static_cast<uint8_t *>(s->start_direct());
             if (xp == NULL)
                 return;
 
-            // Shift buffer
+            // The surface is used as a ring buffer: instead of shifting the whole
+            // image, move the head backwards and overwrite the oldest rows
             size_t stride   = s->stride();
-            ::memmove(&xp[stride * changes], xp, (sData.rows() - changes) * stride);
+            nHead           = (changes >= nRows) ? 0 : (nHead + nRows - changes) % nRows;
 
             // Draw dots
             uint32_t row    = sData.last();
 
-            for (size_t i=1; i<=changes; ++i, xp += stride)
+            for (size_t i=0; i<changes; ++i)
             {
-                const float *p = sData.row(row - i);
+                const float *p = sData.row(row - i - 1);
                 if (p == NULL)
                     continue;
 
-                (this->*pCalcColor)(fRGBA, p, nCols);
-                dsp::rgba_to_bgra32(xp, fRGBA, nCols);
+                lut_to_bgra32(&xp[((nHead + i) % nRows) * stride], p, nCols);
             }
 
             s->end_direct();
@@ -232,12 +277,21 @@ namespace lsp
             sData.advance();
         }
 
+        graph_layer_t GraphFrameBuffer::layer() const
+        {
+            return GLR_DATA;
+        }
+
         void GraphFrameBuffer::render(ws::ISurface *s, const ws::rectangle_t *area, bool force)
         {
             // Check size
             if ((nRows <= 0) || (nCols <= 0))
                 return;
 
+            // The contents of the surface are lost if it is going to be (re)created
+            if ((pSurface == NULL) || (pSurface->width() != nCols) || (pSurface->height() != nRows))
+                bClear          = true;
+
             // Get drawing surface
             ws::ISurface *pp    = get_surface(s, nCols, nRows);
             if (pp == NULL)
@@ -245,6 +299,8 @@ namespace lsp
 
             // Draw surface on the target
             float sx, sy;
+            float cx, cy;   // Offset on the target surface for one column of the buffer
+            float dx, dy;   // Offset on the target surface for one row of the buffer
             float width     = s->width();
             float height    = s->height();
             float ra        = -0.5f * sAngle.get() * M_PI;
@@ -259,6 +315,10 @@ namespace lsp
                 default:
                     sx          = (fw * width ) / nCols;
                     sy          = (fh * height) / nRows;
+                    cx          = sx;
+                    cy          = 0.0f;
+                    dx          = 0.0f;
+                    dy          = sy;
 
                     if (sx < 0.0f)
                         x          -= sx * nCols;
@@ -269,6 +329,10 @@ namespace lsp
                 case 1:
                     sx          = (fw * width ) / nRows;
                     sy          = (fh * height) / nCols;
+                    cx          = 0.0f;
+                    cy          = -sy;
+                    dx          = sx;
+                    dy          = 0.0f;
 
                     if (sx < 0.0f)
                         x          -= sx * nRows;
@@ -279,6 +343,10 @@ namespace lsp
                 case 2:
                     sx          = (fw * width ) / nCols;
                     sy          = (fh * height) / nRows;
+                    cx          = -sx;
+                    cy          = 0.0f;
+                    dx          = 0.0f;
+                    dy          = -sy;
 
                     if (sx > 0.0f)
                         x          += sx * nCols;
@@ -289,6 +357,10 @@ namespace lsp
                 case 3:
                     sx          = (fw * width ) / nRows;
                     sy          = (fh * height) / nCols;
+                    cx          = 0.0f;
+                    cy          = sy;
+                    dx          = -sx;
+                    dy          = 0.0f;
 
                     if (sx > 0.0f)
                         x          += sx * nRows;
@@ -298,7 +370,31 @@ namespace lsp
             }
 
             // Draw the buffer
-            s->draw_rotate_alpha(pp, x, y, sx, sy, ra, sTransparency.get());
+            float alpha     = sTransparency.get();
+            if (nHead <= 0)
+            {
+                s->draw_rotate_alpha(pp, x, y, sx, sy, ra, alpha);
+                return;
+            }
+
+            // The ring buffer is drawn in two parts: surface rows starting at the head
+            // come first, surface rows preceding the head are drawn after them
+            float split     = nRows - nHead;
+            for (size_t i=0; i<2; ++i)
+            {
+                float first     = (i == 0) ? 0.0f : split;
+                float last      = (i == 0) ? split : nRows;
+                float shift     = (i == 0) ? -float(nHead) : split;
+
+                float x1        = x + first * dx;
+                float y1        = y + first * dy;
+                float x2        = x + nCols * cx + last * dx;
+                float y2        = y + nCols * cy + last * dy;
+
+                s->clip_begin(lsp_min(x1, x2), lsp_min(y1, y2), fabsf(x2 - x1), fabsf(y2 - y1));
+                    s->draw_rotate_alpha(pp, x + shift * dx, y + shift * dy, sx, sy, ra, alpha);
+                s->clip_end();
+            }
         }
 
         void GraphFrameBuffer::calc_rainbow_color(float *rgba, const float *v, size_t n)
@@ -92,6 +92,47 @@ namespace lsp
             return false;
         }
 
+        bool GraphItem::hit_area(ws::rectangle_t *r)
+        {
+            r->nLeft        = 0;
+            r->nTop         = 0;
+            r->nWidth       = 0;
+            r->nHeight      = 0;
+            return true;
+        }
+
+        graph_layer_t GraphItem::layer() const
+        {
+            return GLR_STATIC;
+        }
+
+        size_t GraphItem::affected_layers() const
+        {
+            return 1 << layer();
+        }
+
+        void GraphItem::hide_widget()
+        {
+            Widget::hide_widget();
+
+            Graph *gr = graph();
+            if (gr != NULL)
+            {
+                gr->query_hit_index();
+                gr->query_draw_layers(affected_layers());
+            }
+        }
+
+        void GraphItem::show_widget()
+        {
+            Widget::show_widget();
+
+            // The set of items that can be hit has changed
+            Graph *gr = graph();
+            if (gr != NULL)
+                gr->query_hit_index();
+        }
+
         void GraphItem::query_draw(size_t flags)
         {
             Widget::query_draw(flags);
@@ -103,7 +144,7 @@ namespace lsp
             {
                 Graph *gr = graph();
                 if (gr != NULL)
-                    gr->query_draw(REDRAW_SURFACE);
+                    gr->query_draw_layers(affected_layers());
             }
         }
     }
@@ -206,6 +206,11 @@ namespace lsp
                 query_draw();
         }
 
+        graph_layer_t GraphMarker::layer() const
+        {
+            return GLR_MARKERS;
+        }
+
         void GraphMarker::render(ws::ISurface *s, const ws::rectangle_t *area, bool force)
         {
             // Get graph
@@ -409,6 +414,15 @@ namespace lsp
             return distance2d(nx, ny, mx, my) <= range;
         }
 
+        bool GraphMarker::hit_area(ws::rectangle_t *r)
+        {
+            // Editable marker is a line that may cross the graph at any angle
+            if (sEditable.get())
+                return false;
+
+            return GraphItem::hit_area(r);
+        }
+
         status_t GraphMarker::on_mouse_in(const ws::event_t *e)
         {
             if (!sEditable.get())
@@ -176,6 +176,11 @@ namespace lsp
             return off - start;
         }
 
+        graph_layer_t GraphMesh::layer() const
+        {
+            return GLR_DATA;
+        }
+
         void GraphMesh::render(ws::ISurface *s, const ws::rectangle_t *area, bool force)
         {
             // Get graph
@@ -98,6 +98,12 @@ namespace lsp
                 query_draw();
         }
 
+        size_t GraphOrigin::affected_layers() const
+        {
+            // Items of all layers are positioned through axes and origins
+            return (1 << GLR_TOTAL) - 1;
+        }
+
         void GraphOrigin::render(ws::ISurface *s, const ws::rectangle_t *area, bool force)
         {
             // Get graph
@@ -384,17 +384,13 @@ namespace lsp
 
             // Prepare palette
             lsp::Color bg_color;
-            lsp::Color color(select_color());
-            lsp::Color tcolor(select_text_color());
-            lsp::Color border_color(select_border_color());
+            lsp::Color color(select_color().bright_color(brightness));
+            lsp::Color tcolor(select_text_color().bright_color(brightness));
+            lsp::Color border_color(select_border_color().bright_color(brightness));
             lsp::Color xc;
 
             get_actual_bg_color(bg_color);
 
-            color.scale_lch_luminance(brightness);
-            tcolor.scale_lch_luminance(brightness);
-            border_color.scale_lch_luminance(brightness);
-
             // Draw background
             bool aa     = s->set_antialiasing(false);
             s->fill_rect(bg_color, 0, 0, sSize.nWidth, sSize.nHeight);
@@ -192,6 +192,9 @@ namespace lsp
             sTextArea.nWidth    = 0;
             sTextArea.nHeight   = 0;
 
+            fAdvScaling         = 0.0f;
+            bAdvance            = false;
+
             pClass          = &metadata;
         }
 
@@ -217,6 +220,9 @@ namespace lsp
 
         void Edit::do_destroy()
         {
+            vAdvance.flush();
+            bAdvance            = false;
+
             for (size_t i=0; i<4; ++i)
                 if (vMenu[i] != NULL)
                 {
@@ -329,11 +335,15 @@ namespace lsp
                 LSPString *text = sText.formatted();
                 sSelection.set_limit(text->length());
                 sCursor.move(0);
+                bAdvance    = false;
                 query_draw();
             }
 
             if (sFont.is(prop))
+            {
+                bAdvance    = false;
                 query_resize();
+            }
             if (sColor.is(prop))
                 query_draw();
             if (sBorderColor.is(prop))
@@ -460,6 +470,55 @@ namespace lsp
             }
         }
 
+        bool Edit::sync_advance(float fscaling)
+        {
+            LSPString *text = sText.formatted();
+            size_t n        = text->length();
+            if ((bAdvance) && (fAdvScaling == fscaling) && (vAdvance.size() == (n + 1)))
+                return true;
+
+            // Compute the cumulative advance of the text: the advance of each character
+            // and of each pair of adjacent characters is obtained separately, so repeating
+            // characters and pairs are taken from the text cache. The advance of the pair
+            // minus advances of both characters gives the kerning between them
+            vAdvance.clear();
+            float *adv      = vAdvance.append_n(n + 1);
+            if (adv == NULL)
+                return false;
+
+            ws::text_parameters_t tp;
+            float prev      = 0.0f;     // Advance of the previous character
+            adv[0]          = 0.0f;
+            for (size_t i=0; i<n; ++i)
+            {
+                if (!sFont.get_text_parameters(pDisplay, &tp, fscaling, text, i, i + 1))
+                {
+                    vAdvance.clear();
+                    bAdvance        = false;
+                    return false;
+                }
+                float curr      = tp.XAdvance;
+                adv[i+1]        = adv[i] + curr;
+
+                if (i > 0)
+                {
+                    if (!sFont.get_text_parameters(pDisplay, &tp, fscaling, text, i - 1, i + 1))
+                    {
+                        vAdvance.clear();
+                        bAdvance        = false;
+                        return false;
+                    }
+                    adv[i+1]       += tp.XAdvance - prev - curr;
+                }
+                prev            = curr;
+            }
+
+            fAdvScaling     = fscaling;
+            bAdvance        = true;
+
+            return true;
+        }
+
         void Edit::draw(ws::ISurface *s)
         {
             ws::font_parameters_t fp;
@@ -488,8 +547,7 @@ namespace lsp
             // Draw border
             if (border > 0)
             {
-                color.copy(sBorderColor);
-                color.scale_lch_luminance(lightness);
+                color.copy(sBorderColor.bright_color(lightness));
                 s->fill_round_rect(color, SURFMASK_ALL_CORNER, radius, &xr);
 
                 xr.nLeft       += border;
@@ -501,8 +559,7 @@ namespace lsp
                 ssize_t gap     = (sBorderGapSize.get() > 0) ? lsp_max(1.0f, sBorderGapSize.get() * scaling) : 0;
                 if (gap > 0)
                 {
-                    color.copy(sBorderGapColor);
-                    color.scale_lch_luminance(lightness);
+                    color.copy(sBorderGapColor.bright_color(lightness));
                     s->fill_round_rect(color, SURFMASK_ALL_CORNER, radius, &xr);
 
                     xr.nLeft       += gap;
@@ -514,8 +571,7 @@ namespace lsp
             }
 
             // Draw main background
-            color.copy(sColor);
-            color.scale_lch_luminance(lightness);
+            color.copy(sColor.bright_color(lightness));
             s->fill_round_rect(color, SURFMASK_ALL_CORNER, radius, &xr);
 
             // Draw text
@@ -532,9 +588,14 @@ namespace lsp
             size_t cpos     = lsp_limit(sCursor.location(), 0, ssize_t(text->length()));
 
             sFont.get_parameters(s, fscaling, &fp);
-            sFont.get_text_parameters(s, &tp, fscaling, text, 0, cpos);
+            if (!sync_advance(fscaling))
+            {
+                s->clip_end();
+                s->set_antialiasing(aa);
+                return;
+            }
 
-            ssize_t textw   = tp.XAdvance;
+            ssize_t textw   = advance(0, cpos);
             if (sCursor.visible() && sCursor.replacing() && (cpos >= text->length()))
             {
                 sFont.get_text_parameters(s, &tp, fscaling, "_");
@@ -579,38 +640,29 @@ namespace lsp
                 ssize_t last    = sSelection.ending();
                 ssize_t xpos    = xr.nLeft + sTextPos;
 
-                lsp::Color scolor(sSelectionColor);
-                lsp::Color stcolor(sTextSelectedColor);
-                color.copy(sTextColor);
-                color.scale_lch_luminance(lightness);
-                scolor.scale_lch_luminance(lightness);
-                stcolor.scale_lch_luminance(lightness);
+                lsp::Color scolor(sSelectionColor.bright_color(lightness));
+                lsp::Color stcolor(sTextSelectedColor.bright_color(lightness));
+                color.copy(sTextColor.bright_color(lightness));
 
                 ssize_t xshift  = (sSelection.reverted() && sCursor.inserting()) ? cursize : 0;
 
                 if (first > 0)
                 {
-                    sFont.get_text_parameters(s, &tp, fscaling, text, 0, first);
                     sFont.draw(s, color, xpos, xr.nTop + fp.Ascent, fscaling, text, 0, first);
-                    xpos           += tp.XAdvance;
+                    xpos           += advance(0, first);
                 }
 
-                sFont.get_text_parameters(s, &tp, fscaling, text, first, last);
-                s->fill_rect(scolor, xpos + xshift, xr.nTop, tp.XAdvance, xr.nHeight);
+                float sw        = advance(first, last);
+                s->fill_rect(scolor, xpos + xshift, xr.nTop, sw, xr.nHeight);
                 sFont.draw(s, stcolor, xpos, xr.nTop + fp.Ascent, fscaling, text, first, last);
-                xpos           += /*tp.XBearing + */ tp.XAdvance;
+                xpos           += sw;
 
                 if (last < ssize_t(text->length()))
-                {
-                    sFont.get_text_parameters(s, &tp, fscaling, text, last);
                     sFont.draw(s, color, xpos, xr.nTop + fp.Ascent, fscaling, text, last);
-                    xpos           += /*tp.XBearing + */ tp.XAdvance;
-                }
             }
             else
             {
-                color.copy(sTextColor);
-                color.scale_lch_luminance(lightness);
+                color.copy(sTextColor.bright_color(lightness));
 
                 sFont.draw(s, color, xr.nLeft + sTextPos, xr.nTop + fp.Ascent, fscaling, text);
             }
@@ -620,8 +672,7 @@ namespace lsp
             // Draw cursor if required
             if (sCursor.visible() && sCursor.shining())
             {
-                color.copy(sCursorColor);
-                color.scale_lch_luminance(lightness);
+                color.copy(sCursorColor.bright_color(lightness));
 
                 if (sCursor.inserting())
                     s->fill_rect(color, xr.nLeft, xr.nTop, cursize, xr.nHeight);
@@ -635,8 +686,7 @@ namespace lsp
                     else
                     {
                         // Draw background
-                        lsp::Color bcolor(sColor);
-                        bcolor.scale_lch_luminance(lightness);
+                        lsp::Color bcolor(sColor.bright_color(lightness));
 
                         sFont.get_text_parameters(s, &tp, fscaling, text, sCursor.position(), sCursor.position() + 1);
                         ssize_t xw = (tp.XAdvance > tp.Width) ? tp.XAdvance : tp.Width + 1;
@@ -699,50 +749,30 @@ namespace lsp
 
 //            lsp_trace("x=%d", int(x));
 
-            ws::text_parameters_t tp;
-            if (sFont.get_text_parameters(pDisplay, &tp, fscaling, text))
-            {
-                if (x > (tpos + tp.XAdvance))
-                    return text->length();
-            }
+            if (!sync_advance(fscaling))
+                return -1;
+            if (x > (tpos + advance(0, text->length())))
+                return text->length();
 
+            // Lookup the character position using binary search
+            const float *adv    = vAdvance.array();
             ssize_t left = 0, right = text->length();
             while ((right - left) > 1)
             {
-                ssize_t middle = (left + right) >> 1;
-                if (!sFont.get_text_parameters(pDisplay, &tp, fscaling, text, left, middle))
-                    return -1;
-
-                ssize_t tx      = tpos + tp.XAdvance;
-//                lsp_trace("x=%d, tpos=%d, xadvance=%d, tx=%d, left=%d, right=%d, middle=%d",
-//                        int(x), int(tpos), int(tp.XAdvance), int(tx),
-//                        int(left), int(right), int(middle)
-//                    );
+                ssize_t middle  = (left + right) >> 1;
+                ssize_t tx      = tpos + adv[middle];
 
                 if (tx > x)
                     right       = middle;
                 else if (tx < x)
-                {
                     left        = middle;
-                    tpos       += tp.XAdvance;
-                }
                 else // tx == x
                     return middle;
             }
 
             // Position may be somewhere in the middle of character, determine the actual position
-            if (sFont.get_text_parameters(pDisplay, &tp, fscaling, text, left, right))
-            {
-                float tx        = tpos + tp.XAdvance * 0.75f;
-//                lsp_trace("x=%d, tpos=%d, xadvance=%d, tx=%d, left=%d, right=%d",
-//                        int(x), int(tpos), int(tp.XAdvance), int(tx),
-//                        int(left), int(right)
-//                    );
-
-                return (tx < x) ? right : left;
-            }
-
-            return left;
+            float tx        = tpos + adv[left] + (adv[right] - adv[left]) * 0.75f;
+            return (tx < x) ? right : left;
         }
 
         status_t Edit::on_mouse_dbl_click(const ws::event_t *e)
@@ -419,11 +419,10 @@ namespace lsp
                 sdcol.scale_hsl_lightness(sScaleBrightness.get());
             }
 
-            lsp::Color hcol(sHoleColor);
+            lsp::Color hcol(sHoleColor.bright_color(bright));
             lsp::Color bg_color;
 
             get_actual_bg_color(bg_color);
-            hcol.scale_lch_luminance(bright);
             scol.scale_lch_luminance(bright);
             sdcol.scale_lch_luminance(bright);
 
@@ -490,8 +489,7 @@ namespace lsp
                 {
                     if (sBalanceTipColorCustom.get())
                     {
-                        scol.copy(sBalanceTipColor);
-                        scol.scale_lch_luminance(bright);
+                        scol.copy(sBalanceTipColor.bright_color(bright));
                     }
 
                     delta = btsz / (xr - scale * 0.5f);
@@ -515,10 +513,8 @@ namespace lsp
 
             if (sFlat.get())
             {
-                lsp::Color cap(sColor);
-                lsp::Color tip(sTipColor);
-                cap.scale_lch_luminance(bright);
-                tip.scale_lch_luminance(bright);
+                lsp::Color cap(sColor.bright_color(bright));
+                lsp::Color tip(sTipColor.bright_color(bright));
 
                 // Draw cap
                 s->fill_circle(c_x, c_y, xr, cap);
@@ -21,6 +21,7 @@
 
 #include <lsp-plug.in/tk/tk.h>
 #include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/stdlib/math.h>
 #include <private/tk/style/BuiltinStyle.h>
 
 namespace lsp
@@ -88,12 +89,43 @@ namespace lsp
             sFadeOutBorderColor(&sProperties),
             sConstraints(&sProperties)
         {
+            nPeakSamples    = 0;
+            vBuffer         = NULL;
+            nBufSize        = 0;
+            pBufData        = NULL;
+
             pClass          = &metadata;
         }
 
         AudioChannel::~AudioChannel()
         {
             nFlags     |= FINALIZED;
+            do_destroy();
+        }
+
+        void AudioChannel::destroy()
+        {
+            nFlags     |= FINALIZED;
+            Widget::destroy();
+            do_destroy();
+        }
+
+        void AudioChannel::do_destroy()
+        {
+            // The array of samples is not bound to the style, discard it's updates explicitly
+            pDisplay->updates()->discard(&vSamples);
+
+            for (size_t i=0; i<PEAK_LEVELS; ++i)
+                vPeaks[i].flush();
+            nPeakSamples    = 0;
+
+            if (pBufData != NULL)
+            {
+                lsp::free_aligned(pBufData);
+                pBufData        = NULL;
+            }
+            vBuffer         = NULL;
+            nBufSize        = 0;
         }
 
         status_t AudioChannel::init()
@@ -170,41 +202,216 @@ namespace lsp
             sConstraints.apply(r, scaling);
         }
 
+        float *AudioChannel::reserve_buffer(size_t size)
+        {
+            if (size <= nBufSize)
+                return vBuffer;
+
+            // Allocate new buffer
+            uint8_t *data       = NULL;
+            size                = lsp::align_size(size, 16);
+            float *buf          = lsp::alloc_aligned<float>(data, size);
+            if (buf == NULL)
+                return NULL;
+
+            // Replace the previous buffer
+            if (pBufData != NULL)
+                lsp::free_aligned(pBufData);
+
+            vBuffer             = buf;
+            nBufSize            = size;
+            pBufData            = data;
+
+            return vBuffer;
+        }
+
+        void AudioChannel::sync_peaks()
+        {
+            size_t samples      = vSamples.size();
+            size_t first        = lsp_min(vSamples.first_changed(), samples);
+            const float *src    = vSamples.values();
+            size_t block        = PEAK_BLOCK;
+            size_t items        = 0;
+
+            for (size_t l=0; l<PEAK_LEVELS; ++l, block *= PEAK_RATIO)
+            {
+                lltl::darray<peak_t> *level = &vPeaks[l];
+
+                // The level is not needed if the previous one already has single item
+                size_t count        = ((l > 0) && (items <= 1)) ? 0 : (samples + block - 1) / block;
+                size_t start        = lsp_min(first / block, level->size());
+
+                // Resize the level
+                if (level->size() > count)
+                    level->truncate(count);
+                else if (level->size() < count)
+                {
+                    if (level->append_n(count - level->size()) == NULL)
+                    {
+                        // Levels that can not be built are not used for the lookup
+                        for (size_t j=l; j<PEAK_LEVELS; ++j)
+                            vPeaks[j].flush();
+                        break;
+                    }
+                }
+
+                // Update changed items of the level
+                peak_t *dst         = level->array();
+                if (l == 0)
+                {
+                    for (size_t i=start; i<count; ++i)
+                    {
+                        const float *v      = &src[i * block];
+                        size_t n            = lsp_min(samples - i * block, block);
+                        peak_t *p           = &dst[i];
+
+                        p->fMin             = v[0];
+                        p->fMax             = v[0];
+                        p->fSqr             = 0.0f;
+                        for (size_t j=0; j<n; ++j)
+                        {
+                            p->fMin             = lsp_min(p->fMin, v[j]);
+                            p->fMax             = lsp_max(p->fMax, v[j]);
+                            p->fSqr            += v[j] * v[j];
+                        }
+                    }
+                }
+                else
+                {
+                    const peak_t *prev  = vPeaks[l-1].array();
+                    for (size_t i=start; i<count; ++i)
+                    {
+                        const peak_t *v     = &prev[i * PEAK_RATIO];
+                        size_t n            = lsp_min(items - i * PEAK_RATIO, size_t(PEAK_RATIO));
+                        peak_t *p           = &dst[i];
+
+                        *p                  = v[0];
+                        for (size_t j=1; j<n; ++j)
+                        {
+                            p->fMin             = lsp_min(p->fMin, v[j].fMin);
+                            p->fMax             = lsp_max(p->fMax, v[j].fMax);
+                            p->fSqr            += v[j].fSqr;
+                        }
+                    }
+                }
+
+                items               = count;
+            }
+
+            vSamples.commit_changes();
+            nPeakSamples        = samples;
+        }
+
+        void AudioChannel::find_peak(peak_t *p, size_t first, size_t last)
+        {
+            const float *src    = vSamples.values();
+
+            p->fMin             = src[first];
+            p->fMax             = src[first];
+            p->fSqr             = 0.0f;
+
+            for (size_t i=first; i<last; )
+            {
+                // Find the coarsest item of the pyramid that starts at current position and fits the range
+                const peak_t *item  = NULL;
+                size_t step         = 1;
+                for (size_t l=0, block=PEAK_BLOCK; l<PEAK_LEVELS; ++l, block *= PEAK_RATIO)
+                {
+                    if (((i % block) != 0) || ((i + block) > last))
+                        break;
+                    size_t idx          = i / block;
+                    if (idx >= vPeaks[l].size())
+                        break;
+
+                    item                = vPeaks[l].uget(idx);
+                    step                = block;
+                }
+
+                // Apply the summary or the raw sample
+                if (item != NULL)
+                {
+                    p->fMin             = lsp_min(p->fMin, item->fMin);
+                    p->fMax             = lsp_max(p->fMax, item->fMax);
+                    p->fSqr            += item->fSqr;
+                }
+                else
+                {
+                    float v             = src[i];
+                    p->fMin             = lsp_min(p->fMin, v);
+                    p->fMax             = lsp_max(p->fMax, v);
+                    p->fSqr            += v * v;
+                }
+
+                i                  += step;
+            }
+        }
+
+        size_t AudioChannel::get_envelope(float *min, float *max, float *rms, size_t points)
+        {
+            size_t samples      = vSamples.size();
+            size_t n            = lsp_min(samples, points);
+            if (n <= 0)
+                return 0;
+
+            // Update the pyramid if the samples have been changed
+            if ((vSamples.first_changed() < nPeakSamples) || (samples != nPeakSamples))
+                sync_peaks();
+
+            peak_t p;
+            for (size_t i=0; i<n; ++i)
+            {
+                size_t first        = (wsize_t(i) * samples) / n;
+                size_t last         = (wsize_t(i + 1) * samples) / n;
+                find_peak(&p, first, last);
+
+                min[i]              = p.fMin;
+                max[i]              = p.fMax;
+                if (rms != NULL)
+                    rms[i]              = sqrtf(p.fSqr / (last - first));
+            }
+
+            return n;
+        }
+
         void AudioChannel::draw_samples(const ws::rectangle_t *r, ws::ISurface *s, size_t samples, float scaling, float bright)
         {
             // Check limits
             if ((samples <= 0) || (r->nWidth <= 1) || (r->nHeight <= 1))
                 return;
 
-            // Init decimation buffer
-            ssize_t n_draw      = lsp_min(ssize_t(samples), r->nWidth);
-            size_t n_points     = n_draw + 2;
-            size_t n_decim      = lsp::align_size(n_points, 16); // 2 additional points at start and end
-
-            // Try to allocate memory
-            uint8_t *data       = NULL;
-            float *x            = lsp::alloc_aligned<float>(data, n_decim * 2);
-            float *y            = &x[n_decim];
+            // Compute the envelope
+            size_t n_draw       = lsp_min(samples, size_t(r->nWidth));
+            size_t n_points     = n_draw * 2 + 2; // 2 additional points at start and end
+            float *x            = reserve_buffer(n_points * 2 + n_draw * 2);
             if (x == NULL)
                 return;
 
-            // Form the x and y values
+            float *y            = &x[n_points];
+            float *vmin         = &y[n_points];
+            float *vmax         = &vmin[n_draw];
+            n_draw              = get_envelope(vmin, vmax, NULL, n_draw);
+            if (n_draw <= 0)
+                return;
+            n_points            = n_draw * 2 + 2;
+
+            // Form the x and y values: upper contour goes forward, lower contour goes backward
             float border        = (sWaveBorder.get() > 0) ? lsp_max(1.0f, sWaveBorder.get() * scaling) : 0.0f;
-            float dx            = lsp_max(1.0f, float(r->nWidth) / float(samples));
-            float kx            = lsp_max(1.0f, float(samples) / float(r->nWidth));
+            float dx            = float(r->nWidth) / float(n_draw);
             float ky            = -0.5f * (r->nHeight - border);
             float sy            = r->nTop + r->nHeight * 0.5f;
 
             x[0]                = -1.0f;
             y[0]                = sy;
-            x[n_points-1]       = r->nWidth;
-            y[n_points-1]       = sy;
+            x[n_draw+1]         = r->nWidth;
+            y[n_draw+1]         = sy;
 
-            for (ssize_t i=1; i <= n_draw; ++i)
+            for (size_t i=0; i < n_draw; ++i)
             {
-                ssize_t xx          = i - 1;
-                x[i]                = xx * dx;
-                y[i]                = sy + ky * vSamples.get(ssize_t(xx * kx));
+                size_t j            = n_draw - i - 1;
+                x[i+1]              = i * dx;
+                y[i+1]              = sy + ky * lsp_max(vmax[i], 0.0f);
+                x[n_draw+i+2]       = j * dx;
+                y[n_draw+i+2]       = sy + ky * lsp_min(vmin[j], 0.0f);
             }
 
             // Draw the poly
@@ -216,9 +423,6 @@ namespace lsp
             bool aa             = s->set_antialiasing(true);
             s->draw_poly(fill, wire, border, x, y, n_points);
             s->set_antialiasing(aa);
-
-            // Free allocated data
-            lsp::free_aligned(data);
         }
 
         void AudioChannel::draw_fades(const ws::rectangle_t *r, ws::ISurface *s, size_t samples, float scaling, float bright)
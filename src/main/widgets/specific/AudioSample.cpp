@@ -212,12 +212,7 @@ namespace lsp
 
         void AudioSample::drop_glass()
         {
-            if (pGlass != NULL)
-            {
-                pGlass->destroy();
-                delete pGlass;
-                pGlass      = NULL;
-            }
+            drop_surface(&pGlass);
         }
 
         void AudioSample::do_destroy()
@@ -446,50 +441,48 @@ namespace lsp
             float scaling       = lsp_max(0.0f, sScaling.get());
             float bright        = sBrightness.get();
 
-            // Init decimation buffer
-            ssize_t n_draw      = lsp_min(ssize_t(samples), r->nWidth);
-            size_t n_points     = n_draw + 2;
-            size_t n_decim      = lsp::align_size(n_points, 16); // 2 additional points at start and end
-
-            // Try to allocate memory
-            uint8_t *data       = NULL;
-            float *x            = lsp::alloc_aligned<float>(data, n_decim * 2);
-            float *y            = &x[n_decim];
+            // Compute the envelope
+            size_t n_draw       = lsp_min(samples, size_t(r->nWidth));
+            size_t n_points     = n_draw * 2 + 2; // 2 additional points at start and end
+            float *x            = c->reserve_buffer(n_points * 2 + n_draw * 2);
             if (x == NULL)
                 return;
 
-            // Form the x and y values
-            FloatArray *vsamp   = &c->vSamples;
+            float *y            = &x[n_points];
+            float *vmin         = &y[n_points];
+            float *vmax         = &vmin[n_draw];
+            n_draw              = c->get_envelope(vmin, vmax, NULL, n_draw);
+            if (n_draw <= 0)
+                return;
+            n_points            = n_draw * 2 + 2;
+
+            // Form the x and y values: upper contour goes forward, lower contour goes backward
             float border        = (sWaveBorder.get() > 0) ? lsp_max(1.0f, sWaveBorder.get() * scaling) : 0.0f;
-            float dx            = lsp_max(1.0f, float(r->nWidth) / float(samples));
-            float kx            = lsp_max(1.0f, float(samples) / float(r->nWidth));
+            float dx            = float(r->nWidth) / float(n_draw);
             float ky            = -0.5f * (r->nHeight - border);
             float sy            = r->nTop + r->nHeight * 0.5f;
 
             x[0]                = -1.0f;
             y[0]                = sy;
-            x[n_points-1]       = r->nWidth;
-            y[n_points-1]       = sy;
+            x[n_draw+1]         = r->nWidth;
+            y[n_draw+1]         = sy;
 
-            for (ssize_t i=1; i <= n_draw; ++i)
+            for (size_t i=0; i < n_draw; ++i)
             {
-                ssize_t xx          = i - 1;
-                x[i]                = xx * dx;
-                y[i]                = sy + ky * vsamp->get(ssize_t(xx * kx));
+                size_t j            = n_draw - i - 1;
+                x[i+1]              = i * dx;
+                y[i+1]              = sy + ky * lsp_max(vmax[i], 0.0f);
+                x[n_draw+i+2]       = j * dx;
+                y[n_draw+i+2]       = sy + ky * lsp_min(vmin[j], 0.0f);
             }
 
             // Draw the poly
-            lsp::Color fill(c->sColor);
-            lsp::Color wire(c->sWaveBorderColor);
-            fill.scale_lch_luminance(bright);
-            wire.scale_lch_luminance(bright);
+            lsp::Color fill(c->sColor.bright_color(bright));
+            lsp::Color wire(c->sWaveBorderColor.bright_color(bright));
 
             bool aa             = s->set_antialiasing(true);
             s->draw_poly(fill, wire, border, x, y, n_points);
             s->set_antialiasing(aa);
-
-            // Free allocated data
-            lsp::free_aligned(data);
         }
 
         void AudioSample::draw_fades1(const ws::rectangle_t *r, ws::ISurface *s, AudioChannel *c, size_t samples)
@@ -526,10 +519,8 @@ namespace lsp
                 y[4]                = y[3];
                 y[5]                = y[0];
 
-                lsp::Color fill(c->sFadeInColor);
-                lsp::Color wire(c->sFadeInBorderColor);
-                fill.scale_lch_luminance(bright);
-                wire.scale_lch_luminance(bright);
+                lsp::Color fill(c->sFadeInColor.bright_color(bright));
+                lsp::Color wire(c->sFadeInBorderColor.bright_color(bright));
 
                 s->draw_poly(fill, wire, border, x, y, 6);
             }
@@ -555,10 +546,8 @@ namespace lsp
                 y[4]                = y[3];
                 y[5]                = y[0];
 
-                lsp::Color fill(c->sFadeOutColor);
-                lsp::Color wire(c->sFadeOutBorderColor);
-                fill.scale_lch_luminance(bright);
-                wire.scale_lch_luminance(bright);
+                lsp::Color fill(c->sFadeOutColor.bright_color(bright));
+                lsp::Color wire(c->sFadeOutBorderColor.bright_color(bright));
 
                 s->draw_poly(fill, wire, border, x, y, 6);
             }
@@ -575,25 +564,26 @@ namespace lsp
             float scaling       = lsp_max(0.0f, sScaling.get());
             float bright        = sBrightness.get();
 
-            // Init decimation buffer
-            ssize_t n_draw      = lsp_min(ssize_t(samples), r->nWidth);
-            size_t n_points     = n_draw + 2;
-            size_t n_decim      = lsp::align_size(n_points, 16); // 2 additional points at start and end
-
-            // Try to allocate memory
-            uint8_t *data       = NULL;
-            float *x            = lsp::alloc_aligned<float>(data, n_decim * 2);
-            float *y            = &x[n_decim];
+            // Compute the envelope
+            size_t n_draw       = lsp_min(samples, size_t(r->nWidth));
+            size_t n_points     = n_draw + 2; // 2 additional points at start and end
+            float *x            = c->reserve_buffer(n_points * 2 + n_draw * 2);
             if (x == NULL)
                 return;
 
+            float *y            = &x[n_points];
+            float *vmin         = &y[n_points];
+            float *vmax         = &vmin[n_draw];
+            n_draw              = c->get_envelope(vmin, vmax, NULL, n_draw);
+            if (n_draw <= 0)
+                return;
+            n_points            = n_draw + 2;
+
             bool aa             = s->set_antialiasing(true);
 
-            // Form the x and y values for sample 1
-            FloatArray *vsamp   = &c->vSamples;
+            // Form the x and y values for the peak envelope
             float border        = (sWaveBorder.get() > 0) ? lsp_max(1.0f, sWaveBorder.get() * scaling) : 0.0f;
-            float dx            = lsp_max(1.0f, float(r->nWidth) / float(samples));
-            float kx            = lsp_max(1.0f, float(samples) / float(r->nWidth));
+            float dx            = float(r->nWidth) / float(n_draw);
             float ky            = ((down) ? 1.0f : -1.0f) * (r->nHeight - border);
             float sy            = (down) ? r->nTop : r->nTop + r->nHeight;
 
@@ -602,23 +592,18 @@ namespace lsp
             x[n_points-1]       = r->nWidth;
             y[n_points-1]       = sy;
 
-            for (ssize_t i=1; i <= n_draw; ++i)
+            for (size_t i=0; i < n_draw; ++i)
             {
-                ssize_t xx          = i - 1;
-                x[i]                = xx * dx;
-                y[i]                = sy + ky * fabs(vsamp->get(ssize_t(xx * kx)));
+                x[i+1]              = i * dx;
+                y[i+1]              = sy + ky * lsp_max(fabsf(vmin[i]), fabsf(vmax[i]));
             }
 
             // Draw the poly
-            lsp::Color fill(c->sColor);
-            lsp::Color wire(c->sWaveBorderColor);
-            fill.scale_lch_luminance(bright);
-            wire.scale_lch_luminance(bright);
+            lsp::Color fill(c->sColor.bright_color(bright));
+            lsp::Color wire(c->sWaveBorderColor.bright_color(bright));
             s->draw_poly(fill, wire, border, x, y, n_points);
 
-            // Free allocated data
             s->set_antialiasing(aa);
-            lsp::free_aligned(data);
         }
 
         void AudioSample::draw_fades2(const ws::rectangle_t *r, ws::ISurface *s, AudioChannel *c, size_t samples, bool down)
@@ -651,10 +636,8 @@ namespace lsp
                 y[2]                = y[1];
                 y[3]                = y[0];
 
-                lsp::Color fill(c->sFadeInColor);
-                lsp::Color wire(c->sFadeInBorderColor);
-                fill.scale_lch_luminance(bright);
-                wire.scale_lch_luminance(bright);
+                lsp::Color fill(c->sFadeInColor.bright_color(bright));
+                lsp::Color wire(c->sFadeInBorderColor.bright_color(bright));
 
                 s->draw_poly(fill, wire, border, x, y, 4);
             }
@@ -676,10 +659,8 @@ namespace lsp
                 y[2]                = y[1];
                 y[3]                = y[0];
 
-                lsp::Color fill(c->sFadeOutColor);
-                lsp::Color wire(c->sFadeOutBorderColor);
-                fill.scale_lch_luminance(bright);
-                wire.scale_lch_luminance(bright);
+                lsp::Color fill(c->sFadeOutColor.bright_color(bright));
+                lsp::Color wire(c->sFadeOutBorderColor.bright_color(bright));
 
                 s->draw_poly(fill, wire, border, x, y, 4);
             }
@@ -710,8 +691,7 @@ namespace lsp
             sMainFont.get_multitext_parameters(s, &tp, fscaling, &text);
 
             // Draw main text
-            lsp::Color color(sMainColor);
-            color.scale_lch_luminance(bright);
+            lsp::Color color(sMainColor.bright_color(bright));
 
             draw_multiline_text(
                 s, &sMainFont, &xr, color, &fp, &tp,
@@ -758,8 +738,7 @@ namespace lsp
             bool aa             = s->set_antialiasing(true);
 
             // Draw label background
-            lsp::Color color(sLabelBgColor);
-            color.scale_lch_luminance(bright);
+            lsp::Color color(sLabelBgColor.bright_color(bright));
             s->fill_round_rect(color, SURFMASK_ALL_CORNER, rad, &xr);
 
             // Draw label text
@@ -768,8 +747,7 @@ namespace lsp
             xr.nWidth          -= padding * 2;
             xr.nHeight         -= padding * 2;
 
-            color.copy(sLabelColor[idx]);
-            color.scale_lch_luminance(bright);
+            color.copy(sLabelColor[idx].bright_color(bright));
 
             draw_multiline_text(
                 s, &sLabelFont, &xr, color, &fp, &tp,
@@ -787,8 +765,7 @@ namespace lsp
             float bright        = sBrightness.get();
 
             // Draw background
-            lsp::Color color(sColor);
-            color.scale_lch_luminance(bright);
+            lsp::Color color(sColor.bright_color(bright));
             s->clear(color);
 
             // Draw main text if it is required to be shown
@@ -841,9 +818,8 @@ namespace lsp
                     }
 
                     // Draw lines
-                    color.copy(sLineColor);
+                    color.copy(sLineColor.bright_color(bright));
                     xr.nTop             = y + xr.nHeight;
-                    color.scale_lch_luminance(bright);
                     bool aa             = s->set_antialiasing(false);
                     for (size_t i=0; i<items; i += 2)
                     {
@@ -873,9 +849,8 @@ namespace lsp
                     }
 
                     // Draw lines
-                    color.copy(sLineColor);
+                    color.copy(sLineColor.bright_color(bright));
                     xr.nTop             = y;
-                    color.scale_lch_luminance(bright);
                     float sy            = xr.nHeight * 0.5f;
                     bool aa             = s->set_antialiasing(false);
                     for (size_t i=0; i<items; ++i)
@@ -909,10 +884,9 @@ namespace lsp
 
             // Prepare palette
             ws::ISurface *cv;
-            lsp::Color color(sColor);
+            lsp::Color color(sColor.bright_color(bright));
             lsp::Color bg_color;
             get_actual_bg_color(bg_color);
-            color.scale_lch_luminance(bright);
 
             s->clip_begin(area);
             {
@@ -943,10 +917,8 @@ namespace lsp
                 }
 
                 // Draw the glass and the border
-                color.copy(sGlassColor);
-                bg_color.copy(sColor);
-                color.scale_lch_luminance(bright);
-                bg_color.scale_lch_luminance(bright);
+                color.copy(sGlassColor.bright_color(bright));
+                bg_color.copy(sColor.bright_color(bright));
 
                 // Update border width if widget is in pressed state
                 if (pressed)
@@ -955,7 +927,7 @@ namespace lsp
                 bool flat   = sBorderFlat.get();
                 if (sGlass.get())
                 {
-                    cv = create_border_glass(&pGlass, s,
+                    cv = create_border_glass(pDisplay->surface_pool(), &pGlass, s,
                             color, bg_color,
                             SURFMASK_ALL_CORNER, bw, xr,
                             sSize.nWidth, sSize.nHeight, flat
@@ -124,12 +124,45 @@ namespace lsp
             sAAll.nWidth    = 0;
             sAAll.nHeight   = 0;
 
+            pLit            = NULL;
+            pUnlit          = NULL;
+            bSyncStrips     = true;
+            fStripMin       = 0.0f;
+            fStripMax       = 0.0f;
+            fStripBright    = 1.0f;
+
             pClass          = &metadata;
         }
 
         LedMeterChannel::~LedMeterChannel()
         {
             nFlags     |= FINALIZED;
+            do_destroy();
+        }
+
+        void LedMeterChannel::destroy()
+        {
+            nFlags     |= FINALIZED;
+            do_destroy();
+            Widget::destroy();
+        }
+
+        void LedMeterChannel::do_destroy()
+        {
+            drop_strips();
+        }
+
+        void LedMeterChannel::drop_strips()
+        {
+            drop_surface(&pLit);
+            drop_surface(&pUnlit);
+            bSyncStrips     = true;
+        }
+
+        void LedMeterChannel::hide_widget()
+        {
+            Widget::hide_widget();
+            drop_strips();
         }
 
         status_t LedMeterChannel::init()
@@ -181,11 +214,20 @@ namespace lsp
             if (sBalance.is(prop) && (sBalanceVisible.get()))
                 query_draw();
             if (sColor.is(prop))
+            {
+                bSyncStrips     = true;
                 query_draw();
+            }
             if (sValueColor.is(prop))
+            {
+                bSyncStrips     = true;
                 query_draw();
+            }
             if (sValueRanges.is(prop))
+            {
+                bSyncStrips     = true;
                 query_draw();
+            }
             if (sPeakColor.is(prop) && (sPeakVisible.get()))
                 query_draw();
             if (sPeakRanges.is(prop) && (sPeakVisible.get()))
@@ -281,6 +323,7 @@ namespace lsp
         void LedMeterChannel::realize(const ws::rectangle_t *r)
         {
             Widget::realize(r);
+            bSyncStrips         = true;
 
             float scaling       = lsp_max(0.0f, sScaling.get());
             float fscaling      = lsp_max(0.0f, scaling * sFontScaling.get());
@@ -417,13 +460,114 @@ namespace lsp
             }
         }
 
+        void LedMeterChannel::draw_segment(ws::ISurface *s, const lsp::Color *c, float bright, bool lit,
+            float x, float y, float w, float h, float scaling)
+        {
+            lsp::Color fc, bc;
+
+            // Compute color of the segment
+            fc.copy(c);
+            bc.copy(c);
+            fc.scale_lch_luminance(bright);
+            bc.scale_lch_luminance(bright);
+
+            if (lit)
+                bc.alpha(0.5f);
+            else
+            {
+                bc.alpha(0.95f);
+                fc.alpha(0.9f);
+            }
+
+            // Draw the bar
+            s->fill_rect(bc, x, y, w, h);
+            s->fill_rect(fc, x + scaling, y + scaling, lsp_max(0.0f, w - scaling * 2.0f), lsp_max(0.0f, h - scaling * 2.0f));
+        }
+
+        void LedMeterChannel::render_strip(ws::ISurface *s, bool lit, ssize_t angle, float scaling, float bright)
+        {
+            float seg_size      = 4.0f * scaling;
+            float range         = sValue.range();
+            ssize_t segments    = (angle & 1) ? (sAMeter.nHeight / seg_size) : (sAMeter.nWidth / seg_size);
+            float step          = range / lsp_max(1, segments - 1);
+
+            float bx            = ((angle & 3) == 2) ? sAMeter.nWidth  - seg_size : 0.0f;
+            float by            = ((angle & 3) == 1) ? sAMeter.nHeight - seg_size : 0.0f;
+            float bw            = (angle & 1) ? sAMeter.nWidth : seg_size;
+            float bh            = (angle & 1) ? seg_size : sAMeter.nHeight;
+
+            float dx            = ((angle & 1)) ? 0.0f : ((angle & 2) ? -seg_size : seg_size);
+            float dy            = ((angle & 1)) ? ((angle & 2) ? seg_size : -seg_size) : 0.0f;
+
+            float first         = sValue.min();
+            float vmin          = first - 0.5f * step;
+
+            lsp::Color col;
+            col.copy(sColor);
+
+            s->begin();
+                s->clear(col);
+                bool aa             = s->set_antialiasing(true);
+
+                for (ssize_t i=0; i<segments; ++i)
+                {
+                    draw_segment(s, get_color(vmin, &sValueRanges, &sValueColor), bright, lit, bx, by, bw, bh, scaling);
+
+                    // Update coordinates and value
+                    vmin                = first + step * (i + 0.5f);
+                    bx                 += dx;
+                    by                 += dy;
+                }
+
+                s->set_antialiasing(aa);
+            s->end();
+        }
+
+        bool LedMeterChannel::sync_strips(ws::ISurface *s, ssize_t angle, float scaling, float bright)
+        {
+            if ((sAMeter.nWidth <= 0) || (sAMeter.nHeight <= 0))
+                return false;
+
+            // Check that the strips are valid
+            float vmin          = sValue.min();
+            float vmax          = sValue.max();
+            if ((!bSyncStrips) && (pLit != NULL) && (pUnlit != NULL) &&
+                (fStripMin == vmin) && (fStripMax == vmax) && (fStripBright == bright))
+                return true;
+
+            // Allocate surfaces
+            if ((pLit != NULL) && ((pLit->width() != size_t(sAMeter.nWidth)) || (pLit->height() != size_t(sAMeter.nHeight))))
+                drop_surface(&pLit);
+            if ((pUnlit != NULL) && ((pUnlit->width() != size_t(sAMeter.nWidth)) || (pUnlit->height() != size_t(sAMeter.nHeight))))
+                drop_surface(&pUnlit);
+            if (pLit == NULL)
+                pLit                = pDisplay->surface_pool()->acquire(s, sAMeter.nWidth, sAMeter.nHeight);
+            if (pUnlit == NULL)
+                pUnlit              = pDisplay->surface_pool()->acquire(s, sAMeter.nWidth, sAMeter.nHeight);
+            if ((pLit == NULL) || (pUnlit == NULL))
+            {
+                drop_strips();
+                return false;
+            }
+
+            // Render strips
+            render_strip(pLit, true, angle, scaling, bright);
+            render_strip(pUnlit, false, angle, scaling, bright);
+
+            bSyncStrips         = false;
+            fStripMin           = vmin;
+            fStripMax           = vmax;
+            fStripBright        = bright;
+
+            return true;
+        }
+
         void LedMeterChannel::draw_meter(ws::ISurface *s, ssize_t angle, float scaling, float bright)
         {
             float seg_size      = 4.0f * scaling;
             float range         = sValue.range();
             ssize_t segments    = (angle & 1) ? (sAMeter.nHeight / seg_size) : (sAMeter.nWidth / seg_size);
             float step          = range / lsp_max(1, segments - 1);
-            lsp::Color fc, bc;
             const lsp::Color *lc;
 
             float bx            = ((angle & 3) == 2) ? sAMeter.nLeft + sAMeter.nWidth  - seg_size : sAMeter.nLeft;
@@ -431,11 +575,6 @@ namespace lsp
             float bw            = (angle & 1) ? sAMeter.nWidth : seg_size;
             float bh            = (angle & 1) ? seg_size : sAMeter.nHeight;
 
-            float fx            = bx + scaling;
-            float fy            = by + scaling;
-            float fw            = lsp_max(0.0f, bw - scaling * 2.0f);
-            float fh            = lsp_max(0.0f, bh - scaling * 2.0f);
-
             float dx            = ((angle & 1)) ? 0.0f : ((angle & 2) ? -seg_size : seg_size);
             float dy            = ((angle & 1)) ? ((angle & 2) ? seg_size : -seg_size) : 0.0f;
 
@@ -450,71 +589,90 @@ namespace lsp
             float first         = sValue.min();
             float vmin          = first - 0.5f * step;
 
+            // Segments colored with value colors are copied from the pre-rendered strips
+            // as runs of lit and unlit segments, other segments are drawn directly
+            bool strips         = sync_strips(s, angle, scaling, bright);
+            ssize_t run         = -1;       // First segment of the current run
+            bool run_lit        = false;    // State of the current run
+
             float aa            = s->set_antialiasing(true);
 
             s->clip_begin(&sAMeter);
-                for (ssize_t i=0; i<segments; ++i)
+                for (ssize_t i=0; i<=segments; ++i)
                 {
                     float vmax          = first + step * (i + 0.5f);
+                    bool special        = true;
+                    bool matched        = false;
+                    lc                  = NULL;
 
-                    // Estimate the segment color (special values for peak and balance
-                    if ((has_balance) && (vmin <= balance) && (balance < vmax))
-                        lc                  = sBalanceColor.color();
-                    else if ((has_peak) && (vmin <= peak) && (peak < vmax))
-                        lc                  = get_color(peak,  &sPeakRanges, &sPeakColor);
-                    else
-                        lc                  = get_color(vmin, &sValueRanges, &sValueColor);
-
-                    // Now determine if we need to darken the color
-                    bool matched = false;
-
-                    if (active)
+                    if (i < segments)
                     {
-                        if (has_balance)
-                        {
-                            matched     = (balance < value) ?
-                                ((vmax > balance) && (vmin <= value))
-                                : ((vmax > value) && (vmin <= balance));
-
-                            if ((has_balance) && (vmin <= balance) && (balance < vmax))
-                                matched     = !reversive;
-                            else if ((!matched) && (has_peak))
-                                matched     = (peak >= vmin) && (peak < vmax);
-                        }
+                        // Estimate the segment color (special values for peak and balance
+                        if ((has_balance) && (vmin <= balance) && (balance < vmax))
+                            lc                  = sBalanceColor.color();
+                        else if ((has_peak) && (vmin <= peak) && (peak < vmax))
+                            lc                  = get_color(peak,  &sPeakRanges, &sPeakColor);
                         else
+                            special             = false;
+
+                        // Now determine if we need to darken the color
+                        if (active)
                         {
-                            matched     = (vmin < value);
-                            if ((!matched) && (has_peak))
-                                matched     = (peak > vmin) && (peak <= vmax);
+                            if (has_balance)
+                            {
+                                matched     = (balance < value) ?
+                                    ((vmax > balance) && (vmin <= value))
+                                    : ((vmax > value) && (vmin <= balance));
+
+                                if ((has_balance) && (vmin <= balance) && (balance < vmax))
+                                    matched     = !reversive;
+                                else if ((!matched) && (has_peak))
+                                    matched     = (peak >= vmin) && (peak < vmax);
+                            }
+                            else
+                            {
+                                matched     = (vmin < value);
+                                if ((!matched) && (has_peak))
+                                    matched     = (peak > vmin) && (peak <= vmax);
+                            }
+
+                            matched    ^= reversive;
                         }
-
-                        matched    ^= reversive;
                     }
 
-                    // Compute color of the segment
-                    fc.copy(lc);
-                    bc.copy(lc);
-                    fc.scale_lch_luminance(bright);
-                    bc.scale_lch_luminance(bright);
-
-                    if (matched)
-                        bc.alpha(0.5f);
-                    else
+                    // Flush the run of segments if it has been interrupted
+                    if ((run >= 0) && ((special) || (matched != run_lit)))
                     {
-                        bc.alpha(0.95f);
-                        fc.alpha(0.9f);
+                        float x1            = bx + dx * (run - i);
+                        float y1            = by + dy * (run - i);
+                        float x2            = bx - dx;
+                        float y2            = by - dy;
+
+                        s->clip_begin(lsp_min(x1, x2), lsp_min(y1, y2), fabsf(x2 - x1) + bw, fabsf(y2 - y1) + bh);
+                            s->draw((run_lit) ? pLit : pUnlit, sAMeter.nLeft, sAMeter.nTop);
+                        s->clip_end();
+                        run                 = -1;
                     }
+                    if (i >= segments)
+                        break;
 
-                    // Draw the bar
-                    s->fill_rect(bc, bx, by, bw, bh);
-                    s->fill_rect(fc, fx, fy, fw, fh);
+                    // Draw the segment
+                    if ((special) || (!strips))
+                    {
+                        if (lc == NULL)
+                            lc                  = get_color(vmin, &sValueRanges, &sValueColor);
+                        draw_segment(s, lc, bright, matched, bx, by, bw, bh, scaling);
+                    }
+                    else if (run < 0)
+                    {
+                        run                 = i;
+                        run_lit             = matched;
+                    }
 
                     // Update coordinates and value
                     vmin                = vmax;
                     bx                 += dx;
                     by                 += dy;
-                    fx                 += dx;
-                    fy                 += dy;
                 }
             s->clip_end();
 
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-tk-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-tk-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-tk-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-tk-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/tk/tk.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+#include <lsp-plug.in/test-fw/helpers.h>
+
+#define MAX_PROPERTIES      5000
+
+PTEST_BEGIN("tk.style", lookup, 5, 1000)
+
+    tk::Atoms           atoms;
+    tk::atom_t          vAtoms[MAX_PROPERTIES];
+
+    void init_atoms()
+    {
+        char name[64];
+        for (size_t i=0; i<MAX_PROPERTIES; ++i)
+        {
+            sprintf(name, "ptest.property.%d", int(i));
+            vAtoms[i] = atoms.atom_id(name);
+            PTEST_ASSERT(vAtoms[i] >= 0);
+        }
+    }
+
+    void call(tk::Schema *schema, size_t count)
+    {
+        char buf[80];
+        float v;
+
+        tk::Style parent(schema, NULL, NULL);
+        tk::Style child(schema, NULL, NULL);
+        tk::IStyleListener listener;
+
+        PTEST_ASSERT(parent.init() == STATUS_OK);
+        PTEST_ASSERT(child.init() == STATUS_OK);
+        PTEST_ASSERT(child.add_parent(&parent) == STATUS_OK);
+
+        for (size_t i=0; i<count; ++i)
+            PTEST_ASSERT(parent.set_float(vAtoms[i], float(i)) == STATUS_OK);
+
+        printf("Testing style with %d properties...\n", int(count));
+
+        sprintf(buf, "get local x %d", int(count));
+        PTEST_LOOP(buf,
+            for (size_t i=0; i<count; ++i)
+                parent.get_float(vAtoms[i], &v);
+        );
+
+        sprintf(buf, "get inherited x %d", int(count));
+        PTEST_LOOP(buf,
+            for (size_t i=0; i<count; ++i)
+                child.get_float(vAtoms[i], &v);
+        );
+
+        sprintf(buf, "bind/unbind x %d", int(count));
+        PTEST_LOOP(buf,
+            for (size_t i=0; i<count; ++i)
+                child.bind_float(vAtoms[i], &listener);
+            for (size_t i=0; i<count; ++i)
+                child.unbind(vAtoms[i], &listener);
+        );
+    }
+
+    PTEST_MAIN
+    {
+        tk::Schema schema(&atoms, NULL);
+
+        init_atoms();
+
+        call(&schema, 100);
+        call(&schema, 500);
+        call(&schema, 1000);
+        call(&schema, 2000);
+        call(&schema, MAX_PROPERTIES);
+    }
+
+PTEST_END
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-tk-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-tk-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-tk-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-tk-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <lsp-plug.in/tk/tk.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+#include <lsp-plug.in/test-fw/helpers.h>
+
+#define MAX_WIDGETS         5000
+
+PTEST_BEGIN("tk.sys", registry, 5, 1000)
+
+    // The registry does not access widgets, so the addresses of
+    // the array elements are used as widget pointers
+    uint8_t             vDummy[MAX_WIDGETS];
+    char                vIds[MAX_WIDGETS][32];
+
+    inline tk::Widget *widget(size_t i)
+    {
+        return reinterpret_cast<tk::Widget *>(&vDummy[i]);
+    }
+
+    void init_ids()
+    {
+        for (size_t i=0; i<MAX_WIDGETS; ++i)
+            sprintf(vIds[i], "ptest.widget.%d", int(i));
+    }
+
+    void call(tk::Display *dpy, size_t count)
+    {
+        char buf[80];
+
+        printf("Testing registry with %d widgets...\n", int(count));
+
+        // Rebuild the whole page: register widgets and then remove them all
+        sprintf(buf, "rebuild x %d", int(count));
+        PTEST_LOOP(buf,
+            for (size_t i=0; i<count; ++i)
+                dpy->add(widget(i), vIds[i]);
+            for (size_t i=0; i<count; ++i)
+                dpy->remove(widget(i));
+        );
+
+        for (size_t i=0; i<count; ++i)
+            PTEST_ASSERT(dpy->add(widget(i), vIds[i]) == STATUS_OK);
+
+        sprintf(buf, "get x %d", int(count));
+        PTEST_LOOP(buf,
+            for (size_t i=0; i<count; ++i)
+                dpy->get(vIds[i]);
+        );
+
+        sprintf(buf, "exists x %d", int(count));
+        PTEST_LOOP(buf,
+            for (size_t i=0; i<count; ++i)
+                dpy->exists(widget(i));
+        );
+
+        for (size_t i=0; i<count; ++i)
+            PTEST_ASSERT(dpy->remove(vIds[i]) == widget(i));
+    }
+
+    PTEST_MAIN
+    {
+        tk::Display dpy;
+
+        init_ids();
+
+        call(&dpy, 100);
+        call(&dpy, 500);
+        call(&dpy, 1000);
+        call(&dpy, 2000);
+        call(&dpy, MAX_WIDGETS);
+    }
+
+PTEST_END
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-tk-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-tk-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-tk-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-tk-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <lsp-plug.in/tk/tk.h>
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/test-fw/helpers.h>
+#include <lsp-plug.in/io/OutFile.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+using namespace lsp;
+
+UTEST_BEGIN("tk.style", compiled)
+
+    void test_compile(tk::CompiledStyleSheet *cs)
+    {
+        printf("Testing compilation of style sheet...\n");
+        io::Path path;
+        tk::StyleSheet ss;
+
+        UTEST_ASSERT(path.fmt("%s/schema/nesting.xml", resources()) > 0);
+        UTEST_ASSERT(ss.parse_file(&path) == STATUS_OK);
+        UTEST_ASSERT(cs->compile(&ss, 0x1234) == STATUS_OK);
+        UTEST_ASSERT(cs->is_valid());
+        UTEST_ASSERT(cs->source_checksum() == 0x1234);
+
+        // Root style goes first, parents go before children
+        UTEST_ASSERT(cs->styles() == 5);
+        ssize_t base = cs->index_of("TestBase");
+        UTEST_ASSERT(base > 0);
+        UTEST_ASSERT(cs->index_of("TestChild1") > 0);
+        UTEST_ASSERT(cs->index_of("TestChild2") > base);
+        UTEST_ASSERT(cs->index_of("TestChild3") > base);
+        UTEST_ASSERT(cs->index_of("Unknown") < 0);
+    }
+
+    void test_save_load(tk::CompiledStyleSheet *cs)
+    {
+        printf("Testing save and load of compiled style sheet...\n");
+        io::Path path;
+        tk::CompiledStyleSheet xcs;
+
+        UTEST_ASSERT(path.fmt("%s/utest-%s.bin", tempdir(), full_name()) > 0);
+        UTEST_ASSERT(cs->save(&path) == STATUS_OK);
+        UTEST_ASSERT(xcs.load(&path) == STATUS_OK);
+
+        UTEST_ASSERT(xcs.size() == cs->size());
+        UTEST_ASSERT(::memcmp(xcs.data(), cs->data(), cs->size()) == 0);
+        UTEST_ASSERT(xcs.source_checksum() == 0x1234);
+        xcs.close();
+        UTEST_ASSERT(!xcs.is_valid());
+
+        // Damaged file should be rejected
+        io::OutFile os;
+        UTEST_ASSERT(os.open(&path, io::File::FM_WRITE_NEW) == STATUS_OK);
+        UTEST_ASSERT(os.write(cs->data(), cs->size() / 2) == ssize_t(cs->size() / 2));
+        UTEST_ASSERT(os.close() == STATUS_OK);
+        UTEST_ASSERT(xcs.load(&path) != STATUS_OK);
+        UTEST_ASSERT(!xcs.is_valid());
+    }
+
+    void test_apply(tk::CompiledStyleSheet *cs)
+    {
+        printf("Testing application of compiled style sheet...\n");
+        tk::Atoms atoms;
+        tk::Schema schema(&atoms, NULL);
+        tk::Style *s;
+        ssize_t iv;
+        float fv;
+        LSPString sv;
+
+        UTEST_ASSERT(schema.init(NULL, 0) == STATUS_OK);
+        UTEST_ASSERT(schema.apply(cs) == STATUS_OK);
+
+        UTEST_ASSERT(schema.root()->get_float("size.scaling", &fv) == STATUS_OK);
+        UTEST_ASSERT(float_equals_adaptive(fv, 1.5f));
+
+        UTEST_ASSERT((s = schema.get("TestBase")) != NULL);
+        UTEST_ASSERT(s->get_int("int", &iv) == STATUS_OK);
+        UTEST_ASSERT(iv == 48000);
+        UTEST_ASSERT(s->get_float("float", &fv) == STATUS_OK);
+        UTEST_ASSERT(float_equals_adaptive(fv, 1.41f));
+        UTEST_ASSERT(s->get_string("color", &sv) == STATUS_OK);
+        UTEST_ASSERT(sv.equals_ascii("#ccddee"));
+
+        UTEST_ASSERT((s = schema.get("TestChild2")) != NULL);
+        UTEST_ASSERT(s->get_int("int", &iv) == STATUS_OK);
+        UTEST_ASSERT(iv == 48000);
+
+        UTEST_ASSERT((s = schema.get("TestChild3")) != NULL);
+        UTEST_ASSERT(s->get_int("int", &iv) == STATUS_OK);
+        UTEST_ASSERT(iv == 44100);
+        UTEST_ASSERT(s->get_float("float", &fv) == STATUS_OK);
+        UTEST_ASSERT(float_equals_adaptive(fv, 10.0f));
+        UTEST_ASSERT(s->get_string("color", &sv) == STATUS_OK);
+        UTEST_ASSERT(sv.equals_ascii("#5a5a5a"));
+    }
+
+    UTEST_MAIN
+    {
+        tk::CompiledStyleSheet cs;
+
+        test_compile(&cs);
+        test_save_load(&cs);
+        test_apply(&cs);
+    }
+
+UTEST_END
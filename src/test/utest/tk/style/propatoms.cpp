@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-tk-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-tk-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-tk-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-tk-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <lsp-plug.in/tk/tk.h>
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/test-fw/helpers.h>
+
+using namespace lsp;
+
+UTEST_BEGIN("tk.style", propatoms)
+
+    static const tk::prop::desc_t DESC[] =
+    {
+        { "",           tk::PT_STRING   },
+        { ".left",      tk::PT_INT      },
+        { ".right",     tk::PT_INT      },
+        { NULL,         tk::PT_UNKNOWN  }
+    };
+
+    static const char * const FLAGS[] =
+    {
+        ".first",
+        ".second",
+        NULL
+    };
+
+    UTEST_MAIN
+    {
+        tk::Atoms atoms;
+        tk::Schema schema(&atoms, NULL);
+        UTEST_ASSERT(schema.init(NULL, 0) == STATUS_OK);
+
+        // Multi-property atoms should be cached by the descriptor table
+        const tk::atom_t *a1 = schema.property_atoms("padding", DESC);
+        const tk::atom_t *a2 = schema.property_atoms("padding", DESC);
+        UTEST_ASSERT(a1 != NULL);
+        UTEST_ASSERT(a1 == a2);
+        UTEST_ASSERT(a1[0] == atoms.atom_id("padding"));
+        UTEST_ASSERT(a1[1] == atoms.atom_id("padding.left"));
+        UTEST_ASSERT(a1[2] == atoms.atom_id("padding.right"));
+
+        // Other property name produces another entry
+        const tk::atom_t *a3 = schema.property_atoms("margin", DESC);
+        UTEST_ASSERT(a3 != NULL);
+        UTEST_ASSERT(a3 != a1);
+        UTEST_ASSERT(a3 == schema.property_atoms("margin", DESC));
+
+        // Flags are cached by the flag table
+        tk::atom_t id = atoms.atom_id("mode");
+        const tk::atom_t *f1 = schema.property_atoms(id, FLAGS);
+        UTEST_ASSERT(f1 != NULL);
+        UTEST_ASSERT(f1 == schema.property_atoms(id, FLAGS));
+        UTEST_ASSERT(f1[0] == atoms.atom_id("mode.first"));
+        UTEST_ASSERT(f1[1] == atoms.atom_id("mode.second"));
+    }
+
+UTEST_END
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-tk-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-tk-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-tk-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-tk-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <lsp-plug.in/tk/tk.h>
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/test-fw/helpers.h>
+
+using namespace lsp;
+
+UTEST_BEGIN("tk.style", transaction)
+
+    class Listener: public tk::IStyleListener
+    {
+        public:
+            size_t      nCount;
+
+        public:
+            explicit Listener()     { nCount = 0;   }
+
+            virtual void notify(tk::atom_t property)
+            {
+                ++nCount;
+            }
+    };
+
+    UTEST_MAIN
+    {
+        tk::Atoms atoms;
+        tk::Schema schema(&atoms, NULL);
+        tk::StyleSheet sheet;
+        io::Path path;
+        Listener listener;
+        ssize_t value = 0;
+
+        UTEST_ASSERT(schema.init(NULL, 0) == STATUS_OK);
+        UTEST_ASSERT(path.fmt("%s/schema/nesting.xml", resources()) > 0);
+        UTEST_ASSERT(sheet.parse_file(&path) == STATUS_OK);
+
+        // Bind a widget style to the style that is configured after its parent
+        tk::Style *parent = schema.get("TestChild3");
+        UTEST_ASSERT(parent != NULL);
+        tk::Style style(&schema, NULL, NULL);
+        UTEST_ASSERT(style.init() == STATUS_OK);
+        UTEST_ASSERT(style.add_parent(parent) == STATUS_OK);
+        UTEST_ASSERT(style.bind_int("int", &listener) == STATUS_OK);
+        listener.nCount = 0;
+
+        // Both TestBase and TestChild3 change the property, only one notification should be issued
+        UTEST_ASSERT(schema.apply(&sheet) == STATUS_OK);
+        printf("Number of notifications: %d\n", int(listener.nCount));
+        UTEST_ASSERT(listener.nCount == 1);
+        UTEST_ASSERT(style.get_int("int", &value) == STATUS_OK);
+        UTEST_ASSERT(value == 44100);
+
+        // Nothing has changed, no notifications should be issued
+        listener.nCount = 0;
+        UTEST_ASSERT(schema.apply(&sheet) == STATUS_OK);
+        printf("Number of notifications: %d\n", int(listener.nCount));
+        UTEST_ASSERT(listener.nCount == 0);
+
+        UTEST_ASSERT(style.unbind("int", &listener) == STATUS_OK);
+    }
+
+UTEST_END
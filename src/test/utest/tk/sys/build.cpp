@@ -0,0 +1,293 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-tk-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-tk-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-tk-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-tk-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/test-fw/helpers.h>
+#include <lsp-plug.in/tk/tk.h>
+
+UTEST_BEGIN("tk.sys", build)
+
+    typedef struct counter_t
+    {
+        size_t              nResized;
+        size_t              nRealized;
+        ws::rectangle_t     sResized;
+        ws::rectangle_t     sRealized;
+    } counter_t;
+
+    typedef struct nested_t
+    {
+        tk::Display        *pDisplay;
+        tk::Widget         *pResize;       // Widget to realize again in the nested build
+        tk::Widget         *pDestroy;      // Widget to destroy in the nested build
+        ws::rectangle_t     sRect;
+        size_t              nCalls;
+    } nested_t;
+
+    class TestDisplay: public tk::Display
+    {
+        public:
+            size_t pending() const
+            {
+                size_t count = 0;
+                for (size_t i=0, n=vBuild.size(); i<n; ++i)
+                    if (vBuild.uget(i) != NULL)
+                        ++count;
+                return count;
+            }
+    };
+
+    class TestVoid: public tk::Void
+    {
+        public:
+            size_t      nChanged;       // Number of property notifications
+            size_t      nConstraints;   // Number of notifications about size constraints
+
+        public:
+            explicit TestVoid(tk::Display *dpy): tk::Void(dpy)
+            {
+                nChanged        = 0;
+                nConstraints    = 0;
+            }
+
+        protected:
+            virtual void property_changed(tk::Property *prop)
+            {
+                tk::Void::property_changed(prop);
+                ++nChanged;
+                if (sConstraints.is(prop))
+                    ++nConstraints;
+            }
+    };
+
+    static status_t slot_resize(tk::Widget *sender, void *ptr, void *data)
+    {
+        counter_t *c    = static_cast<counter_t *>(ptr);
+        ++c->nResized;
+        c->sResized     = *static_cast<ws::rectangle_t *>(data);
+        return STATUS_OK;
+    }
+
+    static status_t slot_realized(tk::Widget *sender, void *ptr, void *data)
+    {
+        counter_t *c    = static_cast<counter_t *>(ptr);
+        ++c->nRealized;
+        c->sRealized    = *static_cast<ws::rectangle_t *>(data);
+        return STATUS_OK;
+    }
+
+    static status_t slot_nested(tk::Widget *sender, void *ptr, void *data)
+    {
+        nested_t *n     = static_cast<nested_t *>(ptr);
+        if ((n->nCalls++) > 0)
+            return STATUS_OK;
+
+        n->pDisplay->begin_build();
+        {
+            n->pResize->realize_widget(&n->sRect);
+            if (n->pDestroy != NULL)
+            {
+                n->pDestroy->destroy();
+                delete n->pDestroy;
+                n->pDestroy     = NULL;
+            }
+        }
+        return n->pDisplay->end_build();
+    }
+
+    void bind(tk::Widget *w, counter_t *c)
+    {
+        c->nResized     = 0;
+        c->nRealized    = 0;
+        UTEST_ASSERT(w->slots()->bind(tk::SLOT_RESIZE, slot_resize, c) >= 0);
+        UTEST_ASSERT(w->slots()->bind(tk::SLOT_REALIZED, slot_realized, c) >= 0);
+    }
+
+    static bool rect_equals(const ws::rectangle_t *a, const ws::rectangle_t *b)
+    {
+        return (a->nLeft == b->nLeft) && (a->nTop == b->nTop) &&
+            (a->nWidth == b->nWidth) && (a->nHeight == b->nHeight);
+    }
+
+    void test_build()
+    {
+        TestDisplay dpy;
+        counter_t cbox, cv1;
+        ws::rectangle_t r, xr;
+
+        printf("Testing batched construction...\n");
+
+        UTEST_ASSERT(dpy.end_build() == STATUS_BAD_STATE);
+        UTEST_ASSERT(dpy.begin_build() == STATUS_OK);
+        UTEST_ASSERT(dpy.building());
+
+        tk::Box box(&dpy);
+        TestVoid v1(&dpy);
+        tk::Void *v2 = new tk::Void(&dpy);
+        UTEST_ASSERT(v2 != NULL);
+
+        UTEST_ASSERT(box.init() == STATUS_OK);
+        UTEST_ASSERT(v1.init() == STATUS_OK);
+        UTEST_ASSERT(v2->init() == STATUS_OK);
+        UTEST_ASSERT(box.add(&v1) == STATUS_OK);
+        UTEST_ASSERT(box.add(v2) == STATUS_OK);
+        bind(&box, &cbox);
+        bind(&v1, &cv1);
+
+        // Property notifications, including ones issued by binding, are deferred
+        UTEST_ASSERT(v1.nChanged == 0);
+        v1.constraints()->set_min(10, 10);
+        v1.constraints()->set_min(20, 10);
+        v1.constraints()->set_min(30, 10);
+        UTEST_ASSERT(v1.nChanged == 0);
+        UTEST_ASSERT(v1.nConstraints == 0);
+
+        // Nested calls do not finish the build
+        UTEST_ASSERT(dpy.begin_build() == STATUS_OK);
+        UTEST_ASSERT(dpy.end_build() == STATUS_OK);
+        UTEST_ASSERT(dpy.building());
+
+        // Realize the tree twice, no events should be emitted
+        r.nLeft = 0; r.nTop = 0; r.nWidth = 100; r.nHeight = 40;
+        box.realize_widget(&r);
+        r.nWidth = 200; r.nHeight = 80;
+        box.realize_widget(&r);
+        UTEST_ASSERT(cbox.nResized == 0);
+        UTEST_ASSERT(cbox.nRealized == 0);
+        UTEST_ASSERT(cv1.nResized == 0);
+        UTEST_ASSERT(cv1.nRealized == 0);
+
+        // Destroyed widget should be dropped from the list
+        size_t pending = dpy.pending();
+        UTEST_ASSERT(pending >= 3);
+        UTEST_ASSERT(box.remove(v2) == STATUS_OK);
+        v2->destroy();
+        delete v2;
+        UTEST_ASSERT(dpy.pending() == pending - 1);
+
+        // Finish the build: each event should be emitted once with the final size
+        UTEST_ASSERT(dpy.end_build() == STATUS_OK);
+        UTEST_ASSERT(!dpy.building());
+        UTEST_ASSERT(dpy.pending() == 0);
+
+        // Each changed property is reported once
+        printf("Property notifications: %d\n", int(v1.nChanged));
+        UTEST_ASSERT(v1.nChanged > 0);
+        UTEST_ASSERT(v1.nConstraints == 1);
+
+        box.get_rectangle(&xr);
+        UTEST_ASSERT(rect_equals(&xr, &r));
+        UTEST_ASSERT(cbox.nResized == 1);
+        UTEST_ASSERT(cbox.nRealized == 1);
+        UTEST_ASSERT(rect_equals(&cbox.sResized, &r));
+        UTEST_ASSERT(rect_equals(&cbox.sRealized, &r));
+
+        v1.get_rectangle(&xr);
+        UTEST_ASSERT(cv1.nResized == 1);
+        UTEST_ASSERT(cv1.nRealized == 1);
+        UTEST_ASSERT(rect_equals(&cv1.sResized, &xr));
+        UTEST_ASSERT(rect_equals(&cv1.sRealized, &xr));
+
+        // Events are emitted immediately outside of the build
+        r.nWidth = 300;
+        box.realize_widget(&r);
+        UTEST_ASSERT(cbox.nResized == 2);
+        UTEST_ASSERT(cbox.nRealized == 2);
+
+        box.remove_all();
+        v1.destroy();
+        box.destroy();
+    }
+
+    void test_nested()
+    {
+        TestDisplay dpy;
+        counter_t cv1, cv2;
+        nested_t nested;
+        ws::rectangle_t r, xr;
+
+        printf("Testing nested build started from the replay...\n");
+
+        UTEST_ASSERT(dpy.begin_build() == STATUS_OK);
+
+        tk::Void v0(&dpy);
+        tk::Void v1(&dpy);
+        tk::Void v2(&dpy);
+        tk::Void *v3 = new tk::Void(&dpy);
+        UTEST_ASSERT(v3 != NULL);
+
+        UTEST_ASSERT(v0.init() == STATUS_OK);
+        UTEST_ASSERT(v1.init() == STATUS_OK);
+        UTEST_ASSERT(v2.init() == STATUS_OK);
+        UTEST_ASSERT(v3->init() == STATUS_OK);
+
+        // The first widget in the list starts a nested build from the event handler:
+        // it realizes another widget pending in the outer replay and destroys one more
+        nested.pDisplay     = &dpy;
+        nested.pResize      = &v1;
+        nested.pDestroy     = v3;
+        nested.nCalls       = 0;
+        nested.sRect.nLeft  = 10;
+        nested.sRect.nTop   = 10;
+        nested.sRect.nWidth = 50;
+        nested.sRect.nHeight= 20;
+        UTEST_ASSERT(v0.slots()->bind(tk::SLOT_REALIZED, slot_nested, &nested) >= 0);
+        bind(&v1, &cv1);
+        bind(&v2, &cv2);
+
+        r.nLeft = 0; r.nTop = 0; r.nWidth = 30; r.nHeight = 30;
+        v0.realize_widget(&r);
+        v1.realize_widget(&r);
+        v2.realize_widget(&r);
+        v3->realize_widget(&r);
+        UTEST_ASSERT(dpy.pending() == 4);
+
+        UTEST_ASSERT(dpy.end_build() == STATUS_OK);
+        UTEST_ASSERT(!dpy.building());
+        UTEST_ASSERT(dpy.pending() == 0);
+        UTEST_ASSERT(nested.nCalls == 1);
+        UTEST_ASSERT(nested.pDestroy == NULL);
+
+        // The widget realized by the nested build emits events once with the final size
+        v1.get_rectangle(&xr);
+        UTEST_ASSERT(rect_equals(&xr, &nested.sRect));
+        UTEST_ASSERT(cv1.nResized == 1);
+        UTEST_ASSERT(cv1.nRealized == 1);
+        UTEST_ASSERT(rect_equals(&cv1.sResized, &nested.sRect));
+
+        // Other widgets are not affected
+        UTEST_ASSERT(cv2.nResized == 1);
+        UTEST_ASSERT(cv2.nRealized == 1);
+        UTEST_ASSERT(rect_equals(&cv2.sResized, &r));
+
+        v2.destroy();
+        v1.destroy();
+        v0.destroy();
+    }
+
+    UTEST_MAIN
+    {
+        test_build();
+        test_nested();
+    }
+
+UTEST_END
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-tk-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-tk-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-tk-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-tk-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/test-fw/helpers.h>
+#include <lsp-plug.in/tk/tk.h>
+
+UTEST_BEGIN("tk.sys", updatequeue)
+
+    void test_float()
+    {
+        tk::UpdateQueue q;
+        tk::prop::Float a, b;
+
+        printf("Testing float updates...\n");
+        UTEST_ASSERT(q.init(0x1000) == STATUS_OK);
+
+        a.set(0.0f);
+        b.set(0.0f);
+        UTEST_ASSERT(q.drain() == 0);
+
+        // Only the last update of each property should be applied
+        UTEST_ASSERT(q.post(&a, 1.0f));
+        UTEST_ASSERT(q.post(&b, 2.0f));
+        UTEST_ASSERT(q.post(&a, 3.0f));
+        UTEST_ASSERT(q.post(&a, 4.0f));
+        UTEST_ASSERT(a.get() == 0.0f);
+        UTEST_ASSERT(b.get() == 0.0f);
+
+        UTEST_ASSERT(q.drain() == 2);
+        UTEST_ASSERT(a.get() == 4.0f);
+        UTEST_ASSERT(b.get() == 2.0f);
+        UTEST_ASSERT(q.drain() == 0);
+
+        // Discarded updates should not be applied
+        UTEST_ASSERT(q.post(&a, 5.0f));
+        UTEST_ASSERT(q.post(&b, 6.0f));
+        q.discard(&a);
+        UTEST_ASSERT(q.drain() == 1);
+        UTEST_ASSERT(a.get() == 4.0f);
+        UTEST_ASSERT(b.get() == 6.0f);
+    }
+
+    void test_range_float()
+    {
+        tk::UpdateQueue q;
+        tk::prop::RangeFloat a;
+        tk::prop::FloatArray v;
+        float buf[16];
+
+        printf("Testing ranged float and float array updates...\n");
+        UTEST_ASSERT(q.init(0x1000) == STATUS_OK);
+
+        a.set_all(0.0f, -1.0f, 1.0f);
+        for (size_t i=0; i<16; ++i)
+            buf[i]      = i;
+
+        // Only the last update of each property should be applied
+        UTEST_ASSERT(q.post(&a, 0.25f));
+        UTEST_ASSERT(q.post(&v, buf, 16));
+        UTEST_ASSERT(q.post(&a, -0.5f));
+        buf[0]      = 100.0f;
+        UTEST_ASSERT(q.post(&v, buf, 8));
+        UTEST_ASSERT(a.get() == 0.0f);
+        UTEST_ASSERT(v.size() == 0);
+
+        UTEST_ASSERT(q.drain() == 2);
+        UTEST_ASSERT(a.get() == -0.5f);
+        UTEST_ASSERT(v.size() == 8);
+        UTEST_ASSERT(v.get(0) == 100.0f);
+        UTEST_ASSERT(v.get(7) == 7.0f);
+    }
+
+    void test_destroy()
+    {
+        tk::Display dpy;
+        float buf[16];
+
+        printf("Testing updates of destroyed widgets...\n");
+        UTEST_ASSERT(dpy.updates()->init(0x1000) == STATUS_OK);
+        for (size_t i=0; i<16; ++i)
+            buf[i]      = i;
+
+        tk::LedMeterChannel *lm = new tk::LedMeterChannel(&dpy);
+        tk::AudioChannel *ac    = new tk::AudioChannel(&dpy);
+        tk::LedMeterChannel keep(&dpy);
+        UTEST_ASSERT(lm != NULL);
+        UTEST_ASSERT(ac != NULL);
+        UTEST_ASSERT(lm->init() == STATUS_OK);
+        UTEST_ASSERT(ac->init() == STATUS_OK);
+        UTEST_ASSERT(keep.init() == STATUS_OK);
+
+        // Post updates and destroy widgets before the queue is drained
+        UTEST_ASSERT(dpy.updates()->post(lm->value(), 0.5f));
+        UTEST_ASSERT(dpy.updates()->post(lm->peak(), 0.75f));
+        UTEST_ASSERT(dpy.updates()->post(ac->samples(), buf, 16));
+        UTEST_ASSERT(dpy.updates()->post(keep.peak(), 0.25f));
+
+        lm->destroy();
+        delete lm;
+        ac->destroy();
+        delete ac;
+
+        // Only the update of the alive widget should be applied
+        UTEST_ASSERT(dpy.updates()->drain() == 1);
+        UTEST_ASSERT(keep.peak()->get() == 0.25f);
+
+        keep.destroy();
+    }
+
+    void test_overflow()
+    {
+        tk::UpdateQueue q;
+        tk::prop::GraphMeshData m;
+        float x[64], y[64];
+
+        printf("Testing queue overflow and wrapping...\n");
+        UTEST_ASSERT(q.init(0x1000) == STATUS_OK);
+
+        for (size_t i=0; i<64; ++i)
+        {
+            x[i]    = i;
+            y[i]    = i * 2;
+        }
+
+        // Fill the queue until there is no space
+        size_t posted = 0;
+        while (q.post(&m, x, y, 64))
+            ++posted;
+        UTEST_ASSERT(posted > 0);
+        UTEST_ASSERT(q.drain() == 1);
+        UTEST_ASSERT(m.size() == 64);
+        UTEST_ASSERT(m.x()[63] == 63.0f);
+        UTEST_ASSERT(m.y()[63] == 126.0f);
+
+        // Post and drain many times to make records wrap around the buffer
+        for (size_t i=0; i<100; ++i)
+        {
+            x[0]    = i;
+            UTEST_ASSERT(q.post(&m, x, y, 64 - (i % 7)));
+            UTEST_ASSERT(q.post(&m, x, y, 64 - (i % 5)));
+            UTEST_ASSERT(q.drain() == 1);
+            UTEST_ASSERT(m.size() == 64 - (i % 5));
+            UTEST_ASSERT(m.x()[0] == float(i));
+        }
+    }
+
+    UTEST_MAIN
+    {
+        test_float();
+        test_range_float();
+        test_destroy();
+        test_overflow();
+    }
+
+UTEST_END
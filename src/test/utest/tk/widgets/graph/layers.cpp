@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-tk-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-tk-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-tk-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-tk-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <lsp-plug.in/tk/tk.h>
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/test-fw/helpers.h>
+
+using namespace lsp;
+
+UTEST_BEGIN("tk.widgets.graph", layers)
+
+    class TestGraph: public tk::Graph
+    {
+        public:
+            explicit TestGraph(tk::Display *dpy): tk::Graph(dpy) {}
+
+        public:
+            inline size_t   layers() const      { return nLayers;   }
+            inline bool     hit_index() const   { return bHitIndex; }
+            inline void     commit()            { nLayers = 0; bHitIndex = true;    }
+    };
+
+    UTEST_MAIN
+    {
+        tk::Display dpy;
+        TestGraph gr(&dpy);
+        tk::GraphAxis axis(&dpy);
+        tk::GraphOrigin origin(&dpy);
+        tk::GraphMesh mesh(&dpy);
+
+        UTEST_ASSERT(gr.init() == STATUS_OK);
+        UTEST_ASSERT(axis.init() == STATUS_OK);
+        UTEST_ASSERT(origin.init() == STATUS_OK);
+        UTEST_ASSERT(mesh.init() == STATUS_OK);
+        UTEST_ASSERT(gr.add(&axis) == STATUS_OK);
+        UTEST_ASSERT(gr.add(&origin) == STATUS_OK);
+        UTEST_ASSERT(gr.add(&mesh) == STATUS_OK);
+
+        // Change of the mesh invalidates the data layer only and keeps the hit-test index
+        gr.commit();
+        mesh.width()->set(mesh.width()->get() + 1);
+        printf("Layers after mesh change: 0x%x\n", int(gr.layers()));
+        UTEST_ASSERT(gr.layers() == (1 << tk::GLR_DATA));
+        UTEST_ASSERT(gr.hit_index());
+
+        // Change of the axis moves items of all layers and drops the hit-test index
+        gr.commit();
+        axis.max()->set(axis.max()->get() * 2.0f + 1.0f);
+        printf("Layers after axis change: 0x%x\n", int(gr.layers()));
+        UTEST_ASSERT(gr.layers() & (1 << tk::GLR_STATIC));
+        UTEST_ASSERT(gr.layers() & (1 << tk::GLR_DATA));
+        UTEST_ASSERT(gr.layers() & (1 << tk::GLR_MARKERS));
+        UTEST_ASSERT(!gr.hit_index());
+
+        // Change of the origin moves items of all layers too
+        gr.commit();
+        origin.left()->set(origin.left()->get() + 0.5f);
+        printf("Layers after origin change: 0x%x\n", int(gr.layers()));
+        UTEST_ASSERT(gr.layers() & (1 << tk::GLR_DATA));
+        UTEST_ASSERT(gr.layers() & (1 << tk::GLR_MARKERS));
+
+        gr.remove_all();
+        mesh.destroy();
+        origin.destroy();
+        axis.destroy();
+        gr.destroy();
+    }
+
+UTEST_END
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-tk-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-tk-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-tk-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-tk-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <lsp-plug.in/tk/tk.h>
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/test-fw/helpers.h>
+#include <lsp-plug.in/stdlib/math.h>
+
+#define SAMPLES         100003
+#define POINTS          1000
+
+UTEST_BEGIN("tk.widgets.specific", audiochannel)
+
+    float   vMin[POINTS];
+    float   vMax[POINTS];
+    float   vRms[POINTS];
+
+    void check_envelope(tk::AudioChannel *c, size_t points)
+    {
+        const float *v  = c->samples()->values();
+        size_t samples  = c->samples()->size();
+        size_t n        = c->get_envelope(vMin, vMax, vRms, points);
+
+        printf("Checking envelope: samples=%d, points=%d\n", int(samples), int(points));
+        UTEST_ASSERT(n == lsp_min(samples, points));
+
+        for (size_t i=0; i<n; ++i)
+        {
+            size_t first    = (wsize_t(i) * samples) / n;
+            size_t last     = (wsize_t(i + 1) * samples) / n;
+
+            float vmin      = v[first];
+            float vmax      = v[first];
+            double sqr      = 0.0;
+            for (size_t j=first; j<last; ++j)
+            {
+                vmin            = lsp_min(vmin, v[j]);
+                vmax            = lsp_max(vmax, v[j]);
+                sqr            += v[j] * v[j];
+            }
+            float rms       = sqrt(sqr / (last - first));
+
+            UTEST_ASSERT_MSG(vMin[i] == vmin, "min[%d]: %f != %f", int(i), vMin[i], vmin);
+            UTEST_ASSERT_MSG(vMax[i] == vmax, "max[%d]: %f != %f", int(i), vMax[i], vmax);
+            UTEST_ASSERT_MSG(float_equals_relative(vRms[i], rms, 1e-3f), "rms[%d]: %f != %f", int(i), vRms[i], rms);
+        }
+    }
+
+    UTEST_MAIN
+    {
+        tk::Display dpy;
+        tk::AudioChannel c(&dpy);
+        tk::FloatArray *a = c.samples();
+
+        // Fill the whole array
+        float *buf = new float[SAMPLES];
+        for (size_t i=0; i<SAMPLES; ++i)
+            buf[i]      = sinf(i * 0.001f) * (float(rand()) / RAND_MAX);
+
+        UTEST_ASSERT(a->set(buf, SAMPLES) == STATUS_OK);
+        check_envelope(&c, POINTS);
+        check_envelope(&c, 7);
+        check_envelope(&c, 1);
+
+        // Append samples
+        UTEST_ASSERT(a->append(buf, 12345) == STATUS_OK);
+        check_envelope(&c, POINTS);
+
+        // Change samples in the middle
+        for (size_t i=0; i<100; ++i)
+            buf[i]      = 2.0f - i * 0.04f;
+        UTEST_ASSERT(a->set(54321, buf, 100) == STATUS_OK);
+        UTEST_ASSERT(a->set(777, -3.0f) == STATUS_OK);
+        check_envelope(&c, POINTS);
+
+        // Truncate the array
+        UTEST_ASSERT(a->resize(SAMPLES / 3) == STATUS_OK);
+        check_envelope(&c, POINTS);
+        UTEST_ASSERT(a->resize(100) == STATUS_OK);
+        check_envelope(&c, POINTS);
+
+        delete [] buf;
+    }
+
+UTEST_END